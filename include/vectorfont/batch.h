@@ -0,0 +1,309 @@
+//=============================================================================
+//	FILE:					batch.h
+//	SYSTEM:
+//	DESCRIPTION:	Parallel layout of many labels.
+//-----------------------------------------------------------------------------
+//  COPYRIGHT:		(C)Copyright 2026 Adrian Purser. All Rights Reserved.
+//	LICENCE:
+//	MAINTAINER:		AJP - Adrian Purser <ade&arcadestuff.com>
+//	CREATED:			16-OCT-2026 Adrian Purser <ade&arcadestuff.com>
+//-----------------------------------------------------------------------------
+//	A BatchExecutor is a pool of threads that runs a parallel loop. The loop
+//	is split into chunks which are divided between the threads, and a thread
+//	that runs out of chunks steals them from the end of another thread's
+//	queue. The calling thread takes part in the loop. The pool is kept
+//	between calls so it can be used every frame.
+//
+//	layout_segments_batch() lays out a set of labels, each of which is a font,
+//	a string and a transform, with an executor. Fonts are not modified by
+//	reading them so any number of threads can lay out text from the same
+//	font at the same time. The output is in the order of the labels.
+//=============================================================================
+#ifndef GUARD_ADE_VECTORFONT_BATCH_H
+#define GUARD_ADE_VECTORFONT_BATCH_H
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <numeric>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+#include <algorithm>
+#include "vectorfont.h"
+#include "layout.h"
+#include "transform.h"
+
+namespace vectorfont
+{
+
+//-----------------------------------------------------------------------------
+//	BatchExecutor
+//-----------------------------------------------------------------------------
+//	Runs parallel_for() loops on a pool of threads. Only one loop can run on
+//	an executor at a time. The loop body must not throw.
+//-----------------------------------------------------------------------------
+class BatchExecutor
+{
+public:
+	static constexpr size_t	CHUNK_SIZE = 32;		// Loop iterations taken by a thread at a time
+
+private:
+	struct Queue
+	{
+		std::mutex		mutex;
+		size_t				begin	= 0;		// Chunks that have not been taken
+		size_t				end		= 0;
+	};
+
+	std::vector<std::thread>		m_threads;
+	std::unique_ptr<Queue[]>		m_queues;						// One per thread, including the caller
+	std::mutex									m_mutex;
+	std::condition_variable			m_start;
+	std::condition_variable			m_finished;
+	size_t											m_generation	= 0;
+	size_t											m_active			= 0;		// Threads still running the loop
+	bool												m_b_stop			= false;
+
+	void 												(*m_p_invoke)(void * p_fn, size_t begin, size_t end) = nullptr;
+	void *											m_p_fn				= nullptr;
+	size_t											m_count				= 0;
+
+	inline bool		take_chunk(size_t queue, size_t & chunk) noexcept;
+	inline void		run_chunks(size_t queue) noexcept;
+	inline void		worker(size_t queue) noexcept;
+
+public:
+	inline explicit BatchExecutor(size_t thread_count = 0);
+	inline ~BatchExecutor();
+
+	BatchExecutor(const BatchExecutor &) = delete;
+	BatchExecutor & operator=(const BatchExecutor &) = delete;
+
+	size_t		thread_count() const noexcept		{return m_threads.size() + 1;}
+
+	template<typename F>	void	parallel_for(size_t count, F && fn);
+};
+
+//-----------------------------------------------------------------------------
+//	The executor uses thread_count threads, including the calling thread. A
+//	thread count of zero uses one thread per hardware thread.
+//-----------------------------------------------------------------------------
+BatchExecutor::BatchExecutor(size_t thread_count)
+{
+	if(thread_count == 0)
+		thread_count = std::max(std::thread::hardware_concurrency(),1u);
+
+	m_queues = std::make_unique<Queue[]>(thread_count);
+	m_threads.reserve(thread_count - 1);
+	for(size_t queue = 1; queue < thread_count; ++queue)
+		m_threads.emplace_back([this,queue]{worker(queue);});
+}
+
+BatchExecutor::~BatchExecutor()
+{
+	{
+		std::lock_guard lock(m_mutex);
+		m_b_stop = true;
+	}
+	m_start.notify_all();
+	for(auto & thread : m_threads)
+		thread.join();
+}
+
+//-----------------------------------------------------------------------------
+//	Takes a chunk from the front of a thread's own queue or, if that is empty,
+//	steals one from the back of another thread's queue.
+//-----------------------------------------------------------------------------
+bool
+BatchExecutor::take_chunk(size_t queue, size_t & chunk) noexcept
+{
+	{
+		auto & own = m_queues[queue];
+		std::lock_guard lock(own.mutex);
+		if(own.begin < own.end)
+		{
+			chunk = own.begin++;
+			return true;
+		}
+	}
+
+	for(size_t i = 1; i < thread_count(); ++i)
+	{
+		auto & victim = m_queues[(queue + i) % thread_count()];
+		std::lock_guard lock(victim.mutex);
+		if(victim.begin < victim.end)
+		{
+			chunk = --victim.end;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void
+BatchExecutor::run_chunks(size_t queue) noexcept
+{
+	size_t chunk;
+	while(take_chunk(queue,chunk))
+		m_p_invoke(m_p_fn,chunk * CHUNK_SIZE,std::min((chunk + 1) * CHUNK_SIZE,m_count));
+}
+
+void
+BatchExecutor::worker(size_t queue) noexcept
+{
+	size_t generation = 0;
+
+	for(;;)
+	{
+		{
+			std::unique_lock lock(m_mutex);
+			m_start.wait(lock,[&]{return m_b_stop || (m_generation != generation);});
+			if(m_b_stop)
+				return;
+			generation = m_generation;
+		}
+
+		run_chunks(queue);
+
+		std::lock_guard lock(m_mutex);
+		if(--m_active == 0)
+			m_finished.notify_one();
+	}
+}
+
+//-----------------------------------------------------------------------------
+//	parallel_for
+//-----------------------------------------------------------------------------
+//	Calls fn(i) for each i from 0 to count - 1 and returns when they have all
+//	been called. The calls are made from several threads in no particular
+//	order.
+//-----------------------------------------------------------------------------
+template<typename F>
+void
+BatchExecutor::parallel_for(size_t count, F && fn)
+{
+	auto invoke = [](void * p_fn, size_t begin, size_t end)
+	{
+		for(size_t i = begin; i < end; ++i)
+			(*static_cast<std::remove_reference_t<F>*>(p_fn))(i);
+	};
+
+	void * p_fn = const_cast<void *>(static_cast<const void *>(&fn));
+	if((count <= CHUNK_SIZE) || m_threads.empty())
+	{
+		invoke(p_fn,0,count);
+		return;
+	}
+
+	const size_t chunks = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	{
+		std::lock_guard lock(m_mutex);
+		m_p_invoke 	= invoke;
+		m_p_fn 			= p_fn;
+		m_count 		= count;
+		for(size_t queue = 0; queue < thread_count(); ++queue)
+		{
+			std::lock_guard queue_lock(m_queues[queue].mutex);
+			m_queues[queue].begin = chunks * queue / thread_count();
+			m_queues[queue].end 	= chunks * (queue + 1) / thread_count();
+		}
+		m_active = m_threads.size();
+		++m_generation;
+	}
+	m_start.notify_all();
+
+	run_chunks(0);
+
+	std::unique_lock lock(m_mutex);
+	m_finished.wait(lock,[&]{return m_active == 0;});
+}
+
+//-----------------------------------------------------------------------------
+//	A label to lay out. The font must stay valid until the layout has
+//	finished.
+//-----------------------------------------------------------------------------
+template<typename T, typename S = std::string_view>
+struct BasicLabelJob
+{
+	const BasicFont<T> *	p_font;
+	S											string;
+	Affine								affine;
+};
+
+using LabelJob = BasicLabelJob<int16_t>;
+
+//-----------------------------------------------------------------------------
+//	The segments of a batch of labels. The segments of label i are from
+//	job_offsets[i] up to, but not including, job_offsets[i+1]. The vectors
+//	keep their capacity so a batch can be reused each frame without
+//	allocating.
+//-----------------------------------------------------------------------------
+struct SegmentBatch
+{
+	std::vector<float>		x0;
+	std::vector<float>		y0;
+	std::vector<float>		x1;
+	std::vector<float>		y1;
+	std::vector<uint8_t>	caps;
+	std::vector<size_t>		job_offsets;
+
+	size_t	size() const noexcept	{return x0.size();}
+
+	SegmentBuffers<float>	buffers(size_t job) noexcept
+	{
+		const auto first = job_offsets[job];
+		const auto count = job_offsets[job + 1] - first;
+		return {std::span(x0).subspan(first,count),std::span(y0).subspan(first,count),std::span(x1).subspan(first,count),std::span(y1).subspan(first,count),std::span(caps).subspan(first,count)};
+	}
+};
+
+//-----------------------------------------------------------------------------
+//	layout_segments_batch
+//-----------------------------------------------------------------------------
+//	Lays out each label in the jobs as transformed segments, in parallel, and
+//	returns the total number of segments. The segments are counted first so
+//	that each label can then be written straight to its place in the batch.
+//	Labels without a font have no segments.
+//-----------------------------------------------------------------------------
+template<typename R>
+size_t
+layout_segments_batch(BatchExecutor & executor, const R & jobs, SegmentBatch & batch)
+{
+	const size_t count 	= std::size(jobs);
+	const auto first		= std::begin(jobs);
+
+	batch.job_offsets.resize(count + 1);
+	batch.job_offsets[0] = 0;
+	executor.parallel_for(count,[&](size_t job)
+		{
+			const auto & label = first[job];
+			batch.job_offsets[job + 1] = label.p_font ? layout_size(*label.p_font,label.string).segments : 0;
+		});
+	std::partial_sum(batch.job_offsets.begin(),batch.job_offsets.end(),batch.job_offsets.begin());
+
+	const auto total = batch.job_offsets.back();
+	batch.x0.resize(total);
+	batch.y0.resize(total);
+	batch.x1.resize(total);
+	batch.y1.resize(total);
+	batch.caps.resize(total);
+
+	executor.parallel_for(count,[&](size_t job)
+		{
+			const auto & label = first[job];
+			if(label.p_font)
+				layout_segments(*label.p_font,label.string,batch.buffers(job),label.affine);
+		});
+
+	return total;
+}
+
+} // namespace vectorfont
+
+#endif // ! defined GUARD_ADE_VECTORFONT_BATCH_H
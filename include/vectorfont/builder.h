@@ -0,0 +1,633 @@
+//=============================================================================
+//	FILE:					builder.h
+//	SYSTEM:				
+//	DESCRIPTION:	Builds immutable vectorfont objects.
+//-----------------------------------------------------------------------------
+//  COPYRIGHT:		(C)Copyright 2026 Adrian Purser. All Rights Reserved.
+//	LICENCE:
+//	MAINTAINER:		AJP - Adrian Purser <ade&arcadestuff.com>
+//	CREATED:			16-OCT-2026 Adrian Purser <ade&arcadestuff.com>
+//=============================================================================
+#ifndef GUARD_ADE_VECTORFONT_BUILDER_H
+#define GUARD_ADE_VECTORFONT_BUILDER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <span>
+#include <algorithm>
+#include <iterator>
+#include <unordered_map>
+#include <deque>
+#include <memory_resource>
+#include "vectorfont.h"
+
+namespace vectorfont
+{
+
+//-----------------------------------------------------------------------------
+//	BasicFontBuilder
+//-----------------------------------------------------------------------------
+//	Accumulates glyphs and then produces an immutable font with build(). A 
+//	builder can also be created from an existing font to re-process it, e.g.
+//	to reorder or deduplicate its glyphs. The font, and the temporary storage
+//	used while building it, are allocated from the allocator's memory 
+//	resource.
+//-----------------------------------------------------------------------------
+template<typename T>
+class BasicFontBuilder
+{
+public:
+	using allocator_type = typename BasicFont<T>::allocator_type;
+
+private:
+	BasicFont<T>		m_font;
+	bool						m_b_strips = false;		// Build polyline strips
+
+public:
+	explicit BasicFontBuilder(const allocator_type & alloc = {}) : m_font(alloc) {}
+	explicit BasicFontBuilder(const BasicFont<T> & font, const allocator_type & alloc = {}) : m_font(font,alloc), m_b_strips(!font.glyph_strips().empty()) {}
+
+	allocator_type					get_allocator() const noexcept												{return m_font.get_allocator();}
+
+	void										set_id(std::string_view id)														{m_font.m_id = id;}
+	void										set_metrics(int16_t ascent,int16_t descent,int16_t units_per_em)	{m_font.m_ascent = ascent; m_font.m_descent = descent; m_font.m_units_per_em = units_per_em;}
+	void										set_missing_advance(T advance_x)											{m_font.m_missing_adv_x = advance_x;}
+	inline void							set_lod_tolerances(std::span<const float> tolerances);
+	void										set_build_strips(bool b_strips = true)								{m_b_strips = b_strips;}
+
+	const BasicFont<T> &		font() const noexcept																	{return m_font;}
+	size_t									glyph_count() const noexcept													{return m_font.glyph_count();}
+	inline void							reserve(size_t glyphs, size_t primitives, size_t parameters);
+
+	inline bool							start_glyph(uint32_t code, T advance_x);
+	inline bool							moveto(T x, T y);	
+	inline bool							lineto(T x, T y, int linecap = vectorfont::cap::ROUND);
+
+	inline void							reorder(const GlyphHistogram & histogram);
+	inline size_t						deduplicate();
+	inline void							repack(std::span<const size_t> order);
+
+private:
+	inline void							build_lods(BasicFont<T> & font) const;
+	inline void							build_strips(BasicFont<T> & font) const;
+
+public:
+
+	inline BasicFontPtr<T>	build();
+};
+
+using FontBuilder = BasicFontBuilder<int16_t>;
+
+//-----------------------------------------------------------------------------
+//	reserve
+//-----------------------------------------------------------------------------
+//	Reserves space for the glyphs and geometry that are going to be added so
+//	that the arrays don't need to grow, and over-allocate, while building.
+//-----------------------------------------------------------------------------
+template<typename T>
+void BasicFontBuilder<T>::reserve(size_t glyphs, size_t primitives, size_t parameters)
+{
+	m_font.m_glyph_codes.reserve(glyphs);
+	m_font.m_glyph_advances.reserve(glyphs);
+	m_font.m_glyph_ranges.reserve(glyphs);
+	m_font.m_glyph_rects.reserve(glyphs);
+	m_font.m_primitives.reserve(primitives);
+	m_font.m_parameters.reserve(parameters);
+}
+
+//-----------------------------------------------------------------------------
+//	set_lod_tolerances
+//-----------------------------------------------------------------------------
+//	Sets the tolerances, in font units, of the simplified levels of detail 
+//	that build() generates. Each level is the full geometry with every stroke
+//	simplified until no point is removed that is further than the tolerance
+//	from the simplified stroke.
+//-----------------------------------------------------------------------------
+template<typename T>
+void BasicFontBuilder<T>::set_lod_tolerances(std::span<const float> tolerances)
+{
+	auto & lods = m_font.m_lod_tolerances;
+	lods.clear();
+	std::copy_if(begin(tolerances),end(tolerances),std::back_inserter(lods),[](float tolerance){return tolerance > 0.0f;});
+	std::sort(begin(lods),end(lods));
+	lods.erase(std::unique(begin(lods),end(lods)),end(lods));
+}
+
+//-----------------------------------------------------------------------------
+//	start_glyph / moveto / lineto
+//-----------------------------------------------------------------------------
+//	Build the font one glyph at a time. These return false, and leave the 
+//	font unchanged, if the primitive or parameter arrays would grow beyond
+//	what index_type can address.
+//-----------------------------------------------------------------------------
+template<typename T>
+bool BasicFontBuilder<T>::start_glyph(uint32_t code, T advance_x )
+{
+	if(m_font.glyph_count() >= BasicFont<T>::NO_GLYPH)
+		return false;
+
+	m_font.m_glyph_codes.push_back(code);
+	m_font.m_glyph_advances.push_back(advance_x);
+	m_font.m_glyph_ranges.push_back({static_cast<index_type>(m_font.m_parameters.size()),static_cast<index_type>(m_font.m_primitives.size()),0});
+	m_font.m_glyph_rects.emplace_back();
+	return true;
+}
+
+template<typename T>
+bool BasicFontBuilder<T>::moveto(T x, T y)
+{
+	if(((m_font.m_parameters.size() + 2) > BasicFont<T>::MAX_INDEX) || ((m_font.m_primitives.size() + 1) > BasicFont<T>::MAX_INDEX))
+		return false;
+
+	if(!m_font.m_glyph_codes.empty())
+	{
+		m_font.m_parameters.push_back(x);
+		m_font.m_parameters.push_back(y);
+
+		Primitive primitive;
+		primitive.command = vectorfont::command::MOVETO;
+		primitive.cap			= 0;
+		m_font.m_primitives.push_back(primitive);
+
+		m_font.m_glyph_ranges.back().primitive_count++;
+		m_font.m_glyph_rects.back().add(x,y);
+		m_font.m_rect.add(x,y);
+	}
+	return true;
+}
+
+template<typename T>
+bool BasicFontBuilder<T>::lineto(T x, T y, int linecap)
+{
+	if(((m_font.m_parameters.size() + 2) > BasicFont<T>::MAX_INDEX) || ((m_font.m_primitives.size() + 1) > BasicFont<T>::MAX_INDEX))
+		return false;
+
+	if(!m_font.m_glyph_codes.empty())
+	{
+		m_font.m_parameters.push_back(x);
+		m_font.m_parameters.push_back(y);
+
+		Primitive primitive;
+		primitive.command = vectorfont::command::LINETO;
+		primitive.cap			= linecap;
+		m_font.m_primitives.push_back(primitive);
+
+		m_font.m_glyph_ranges.back().primitive_count++;
+		m_font.m_glyph_rects.back().add(x,y);
+		m_font.m_rect.add(x,y);
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+//	reorder
+//-----------------------------------------------------------------------------
+//	Re-packs the glyph, primitive and parameter arrays so that glyphs are 
+//	stored in order of descending use in the histogram. Glyphs with the same
+//	count keep their relative order. The glyph index is rebuilt so glyph 
+//	indices change but codes resolve to the same glyphs.
+//-----------------------------------------------------------------------------
+template<typename T>
+void BasicFontBuilder<T>::reorder(const GlyphHistogram & histogram)
+{
+	std::pmr::vector<uint64_t> 	counts(m_font.glyph_count(),get_allocator());
+	std::pmr::vector<size_t> 		order(m_font.glyph_count(),get_allocator());
+	for(size_t index = 0; index < m_font.glyph_count(); ++index)
+	{
+		counts[index] = histogram.count(m_font.m_glyph_codes[index]);
+		order[index] 	= index;
+	}
+	std::sort(begin(order),end(order),[&](size_t a, size_t b){return counts[a] != counts[b] ? counts[a] > counts[b] : a < b;});
+	repack(order);
+}
+
+//-----------------------------------------------------------------------------
+//	deduplicate
+//-----------------------------------------------------------------------------
+//	Finds glyphs with identical geometry, such as a glyph mapped to several
+//	codes, and makes them share a single primitive and parameter range. The
+//	unused copies are then removed from the arrays. Returns the number of
+//	bytes that were saved.
+//-----------------------------------------------------------------------------
+template<typename T>
+size_t BasicFontBuilder<T>::deduplicate()
+{
+	const auto size_before = m_font.m_parameters.size() * sizeof(T) + m_font.m_primitives.size() * sizeof(vectorfont::Primitive);
+
+	auto same_geometry = [&](const vectorfont::GlyphRange & a, const vectorfont::GlyphRange & b)
+	{
+		if(a.primitive_count != b.primitive_count)
+			return false;
+
+		size_t param_count = 0;
+		for(index_type i = 0; i < a.primitive_count; ++i)
+		{
+			const auto pa = m_font.m_primitives[a.primitive_index + i];
+			const auto pb = m_font.m_primitives[b.primitive_index + i];
+			if((pa.command != pb.command) || (pa.cap != pb.cap))
+				return false;
+			param_count += parameter_count(pa);
+		}
+
+		return std::equal(begin(m_font.m_parameters) + a.parameter_index,begin(m_font.m_parameters) + a.parameter_index + param_count,begin(m_font.m_parameters) + b.parameter_index);
+	};
+
+	// FNV-1a hash of the m_font.m_primitives and m_font.m_parameters of each glyph.
+	auto hash_geometry = [&](const vectorfont::GlyphRange & range)
+	{
+		uint64_t hash = 14695981039346656037ULL;
+		auto mix = [&hash](uint64_t value){hash = (hash ^ value) * 1099511628211ULL;};
+
+		auto param_index = range.parameter_index;
+		for(index_type i = 0; i < range.primitive_count; ++i)
+		{
+			const auto primitive = m_font.m_primitives[range.primitive_index + i];
+			mix((primitive.command << 4) | primitive.cap);
+			for(size_t count = parameter_count(primitive); count > 0; --count)
+				mix(std::hash<T>{}(m_font.m_parameters[param_index++]));
+		}
+		return hash;
+	};
+
+	std::pmr::unordered_multimap<uint64_t,size_t> unique_glyphs(get_allocator());
+
+	for(size_t index = 0; index < m_font.glyph_count(); ++index)
+	{
+		auto & range = m_font.m_glyph_ranges[index];
+		if(range.primitive_count == 0)
+			continue;
+
+		const auto hash = hash_geometry(range);
+		auto [ibegin,iend] = unique_glyphs.equal_range(hash);
+		auto ifind = std::find_if(ibegin,iend,[&](const auto & entry){return same_geometry(m_font.m_glyph_ranges[entry.second],range);});
+
+		if(ifind != iend)
+			range = m_font.m_glyph_ranges[ifind->second];
+		else
+			unique_glyphs.emplace(hash,index);
+	}
+
+	std::pmr::vector<size_t> order(m_font.glyph_count(),get_allocator());
+	for(size_t index = 0; index < m_font.glyph_count(); ++index)
+		order[index] = index;
+	repack(order);
+
+	return size_before - (m_font.m_parameters.size() * sizeof(T) + m_font.m_primitives.size() * sizeof(vectorfont::Primitive));
+}
+
+//-----------------------------------------------------------------------------
+//	repack
+//-----------------------------------------------------------------------------
+//	Rebuilds the glyph, primitive and parameter arrays with the glyphs in the
+//	specified order. Glyphs that share geometry continue to share it and 
+//	geometry that is not referenced by any glyph is dropped.
+//-----------------------------------------------------------------------------
+template<typename T>
+void BasicFontBuilder<T>::repack(std::span<const size_t> order)
+{
+	const auto alloc = get_allocator();
+	decltype(m_font.m_parameters)			new_parameters(alloc);
+	decltype(m_font.m_primitives)			new_primitives(alloc);
+	decltype(m_font.m_glyph_codes)		new_codes(alloc);
+	decltype(m_font.m_glyph_advances)	new_advances(alloc);
+	decltype(m_font.m_glyph_ranges)		new_ranges(alloc);
+	decltype(m_font.m_glyph_rects)		new_rects(alloc);
+
+	new_parameters.reserve(m_font.m_parameters.size());
+	new_primitives.reserve(m_font.m_primitives.size());
+	new_codes.reserve(m_font.glyph_count());
+	new_advances.reserve(m_font.glyph_count());
+	new_ranges.reserve(m_font.glyph_count());
+	new_rects.reserve(m_font.glyph_count());
+
+	// Maps a primitive index in the old arrays to the range it was moved to.
+	std::pmr::unordered_map<index_type,vectorfont::GlyphRange> moved(alloc);
+
+	for(const auto index : order)
+	{
+		const auto & range = m_font.m_glyph_ranges[index];
+		vectorfont::GlyphRange new_range{static_cast<index_type>(new_parameters.size()),static_cast<index_type>(new_primitives.size()),0};
+
+		if(range.primitive_count > 0)
+		{
+			if(auto ifind = moved.find(range.primitive_index); ifind != end(moved))
+				new_range = ifind->second;
+			else
+			{
+				const auto pbegin = begin(m_font.m_primitives) + range.primitive_index;
+				const auto pend 	= pbegin + range.primitive_count;
+				size_t param_count = 0;
+				std::for_each(pbegin,pend,[&](vectorfont::Primitive primitive){param_count += parameter_count(primitive);});
+
+				new_primitives.insert(end(new_primitives),pbegin,pend);
+				new_parameters.insert(end(new_parameters),begin(m_font.m_parameters) + range.parameter_index,begin(m_font.m_parameters) + range.parameter_index + param_count);
+				new_range.primitive_count = range.primitive_count;
+				moved.emplace(range.primitive_index,new_range);
+			}
+		}
+
+		new_codes.push_back(m_font.m_glyph_codes[index]);
+		new_advances.push_back(m_font.m_glyph_advances[index]);
+		new_ranges.push_back(new_range);
+		new_rects.push_back(m_font.m_glyph_rects[index]);
+	}
+
+	m_font.m_parameters 			= std::move(new_parameters);
+	m_font.m_primitives 			= std::move(new_primitives);
+	m_font.m_glyph_codes 		= std::move(new_codes);
+	m_font.m_glyph_advances 	= std::move(new_advances);
+	m_font.m_glyph_ranges 		= std::move(new_ranges);
+	m_font.m_glyph_rects 		= std::move(new_rects);
+}
+
+//-----------------------------------------------------------------------------
+//	build_lods
+//-----------------------------------------------------------------------------
+//	Generates the levels of detail by simplifying each stroke (a MOVETO and
+//	the LINETOs that follow it) with the Douglas-Peucker algorithm. Glyphs
+//	that share geometry share it in every level. Levels that would overflow
+//	index_type are dropped.
+//-----------------------------------------------------------------------------
+template<typename T>
+void BasicFontBuilder<T>::build_lods(BasicFont<T> & font) const
+{
+	const auto alloc = get_allocator();
+	font.m_lod_parameters.clear();
+	font.m_lod_primitives.clear();
+	font.m_lod_ranges.clear();
+
+	std::pmr::vector<T>						points(alloc);		// x,y of each point in the stroke
+	std::pmr::vector<uint8_t>			caps(alloc);
+	std::pmr::vector<bool>				keep(alloc);
+	std::pmr::vector<std::pair<size_t,size_t>>	stack(alloc);
+	std::pmr::unordered_map<index_type,vectorfont::GlyphRange> simplified(alloc);
+
+	auto distance_squared = [&](size_t point, size_t first, size_t last)
+	{
+		const double px = points[point * 2], py = points[point * 2 + 1];
+		const double ax = points[first * 2], ay = points[first * 2 + 1];
+		const double dx = points[last * 2] - ax, dy = points[last * 2 + 1] - ay;
+		const double length = dx * dx + dy * dy;
+		const double t = length > 0.0 ? std::clamp(((px - ax) * dx + (py - ay) * dy) / length,0.0,1.0) : 0.0;
+		const double ex = ax + t * dx - px, ey = ay + t * dy - py;
+		return ex * ex + ey * ey;
+	};
+
+	auto emit_stroke = [&](double tolerance)
+	{
+		const size_t count = caps.size();
+		if(count == 0)
+			return;
+
+		keep.assign(count,false);
+		keep.front() = keep.back() = true;
+		stack.assign(1,{0,count - 1});
+		while(!stack.empty())
+		{
+			const auto [first,last] = stack.back();
+			stack.pop_back();
+
+			double max_distance = 0.0;
+			size_t max_point = first;
+			for(size_t point = first + 1; point < last; ++point)
+				if(const auto distance = distance_squared(point,first,last); distance > max_distance)
+				{
+					max_distance	= distance;
+					max_point			= point;
+				}
+
+			if(max_distance > tolerance * tolerance)
+			{
+				keep[max_point] = true;
+				stack.emplace_back(first,max_point);
+				stack.emplace_back(max_point,last);
+			}
+		}
+
+		for(size_t point = 0; point < count; ++point)
+			if(keep[point])
+			{
+				vectorfont::Primitive primitive;
+				primitive.command = point ? vectorfont::command::LINETO : vectorfont::command::MOVETO;
+				primitive.cap			= caps[point];
+				font.m_lod_primitives.push_back(primitive);
+				font.m_lod_parameters.push_back(points[point * 2]);
+				font.m_lod_parameters.push_back(points[point * 2 + 1]);
+			}
+		points.clear();
+		caps.clear();
+	};
+
+	for(size_t level = 0; level < font.m_lod_tolerances.size(); ++level)
+	{
+		const double tolerance 	= font.m_lod_tolerances[level];
+		const auto param_size		= font.m_lod_parameters.size();
+		const auto prim_size		= font.m_lod_primitives.size();
+		simplified.clear();
+
+		for(const auto & range : font.m_glyph_ranges)
+		{
+			if(auto ifind = simplified.find(range.primitive_index); (range.primitive_count > 0) && (ifind != end(simplified)))
+			{
+				font.m_lod_ranges.push_back(ifind->second);
+				continue;
+			}
+
+			vectorfont::GlyphRange lod_range{static_cast<index_type>(std::min(font.m_lod_parameters.size(),BasicFont<T>::MAX_INDEX)),static_cast<index_type>(std::min(font.m_lod_primitives.size(),BasicFont<T>::MAX_INDEX)),0};
+			auto param_index = range.parameter_index;
+			for(const auto primitive : std::span(font.m_primitives).subspan(range.primitive_index,range.primitive_count))
+			{
+				if(primitive.command == vectorfont::command::MOVETO)
+					emit_stroke(tolerance);
+				if(parameter_count(primitive) == 2)
+				{
+					points.push_back(font.m_parameters[param_index]);
+					points.push_back(font.m_parameters[param_index + 1]);
+					caps.push_back(primitive.cap);
+				}
+				param_index += parameter_count(primitive);
+			}
+			emit_stroke(tolerance);
+
+			lod_range.primitive_count = static_cast<index_type>(std::min(font.m_lod_primitives.size() - lod_range.primitive_index,BasicFont<T>::MAX_INDEX));
+			font.m_lod_ranges.push_back(lod_range);
+			simplified.emplace(range.primitive_index,lod_range);
+		}
+
+		if((font.m_lod_parameters.size() > BasicFont<T>::MAX_INDEX) || (font.m_lod_primitives.size() > BasicFont<T>::MAX_INDEX))
+		{
+			font.m_lod_parameters.resize(param_size);
+			font.m_lod_primitives.resize(prim_size);
+			font.m_lod_ranges.resize(level * font.glyph_count());
+			font.m_lod_tolerances.resize(level);
+			break;
+		}
+	}
+
+	font.m_lod_parameters.shrink_to_fit();
+	font.m_lod_primitives.shrink_to_fit();
+	font.m_lod_ranges.shrink_to_fit();
+	font.m_lod_tolerances.shrink_to_fit();
+}
+
+//-----------------------------------------------------------------------------
+//	build_strips
+//-----------------------------------------------------------------------------
+//	Joins the strokes of each glyph into polyline strips. Starting from the
+//	first unused stroke, any stroke with an end that coincides with an end
+//	of the strip is added to it, reversed if necessary, until no more can be
+//	joined. Strokes with a single point draw nothing and are dropped. Glyphs
+//	that share geometry share their strips.
+//
+//	The strips hold about as many coordinates as the font itself, so they
+//	are only built when enabled with set_build_strips().
+//-----------------------------------------------------------------------------
+template<typename T>
+void BasicFontBuilder<T>::build_strips(BasicFont<T> & font) const
+{
+	const auto alloc = get_allocator();
+	font.m_strip_vertices.clear();
+	font.m_strip_offsets.clear();
+	font.m_glyph_strips.clear();
+
+	std::pmr::vector<T>						points(alloc);		// x,y of each point in the glyph
+	std::pmr::vector<std::pair<size_t,size_t>>	strokes(alloc);		// First and last point
+	std::pmr::vector<bool>				used(alloc);
+	std::pmr::deque<size_t>				strip(alloc);
+	std::pmr::unordered_map<index_type,vectorfont::GlyphStrips> joined(alloc);
+
+	auto same_point = [&](size_t a, size_t b)
+	{
+		return (points[a * 2] == points[b * 2]) && (points[a * 2 + 1] == points[b * 2 + 1]);
+	};
+
+	auto join_stroke = [&](size_t stroke)
+	{
+		const auto [first,last] = strokes[stroke];
+		if(same_point(strip.back(),first))
+			for(size_t point = first + 1; point <= last; ++point)
+				strip.push_back(point);
+		else if(same_point(strip.back(),last))
+			for(size_t point = last; point-- > first;)
+				strip.push_back(point);
+		else if(same_point(strip.front(),last))
+			for(size_t point = last; point-- > first;)
+				strip.push_front(point);
+		else if(same_point(strip.front(),first))
+			for(size_t point = first + 1; point <= last; ++point)
+				strip.push_front(point);
+		else
+			return false;
+		used[stroke] = true;
+		return true;
+	};
+
+	for(const auto & range : font.m_glyph_ranges)
+	{
+		if(auto ifind = joined.find(range.primitive_index); (range.primitive_count > 0) && (ifind != end(joined)))
+		{
+			font.m_glyph_strips.push_back(ifind->second);
+			continue;
+		}
+
+		points.clear();
+		strokes.clear();
+		auto param_index = range.parameter_index;
+		for(const auto primitive : std::span(font.m_primitives).subspan(range.primitive_index,range.primitive_count))
+		{
+			if(parameter_count(primitive) == 2)
+			{
+				if((primitive.command == vectorfont::command::MOVETO) || strokes.empty())
+					strokes.emplace_back(points.size() / 2,points.size() / 2);
+				else
+					strokes.back().second = points.size() / 2;
+				points.push_back(font.m_parameters[param_index]);
+				points.push_back(font.m_parameters[param_index + 1]);
+			}
+			param_index += parameter_count(primitive);
+		}
+		std::erase_if(strokes,[](const auto & stroke) {return stroke.first == stroke.second;});
+		used.assign(strokes.size(),false);
+
+		vectorfont::GlyphStrips glyph_strips{static_cast<index_type>(std::min(font.m_strip_offsets.size(),BasicFont<T>::MAX_INDEX)),0};
+		for(size_t stroke = 0; stroke < strokes.size(); ++stroke)
+		{
+			if(used[stroke])
+				continue;
+
+			used[stroke] = true;
+			strip.clear();
+			for(size_t point = strokes[stroke].first; point <= strokes[stroke].second; ++point)
+				strip.push_back(point);
+
+			for(bool b_joined = true; b_joined;)
+			{
+				b_joined = false;
+				for(size_t other = stroke + 1; other < strokes.size(); ++other)
+					if(!used[other] && join_stroke(other))
+						b_joined = true;
+			}
+
+			font.m_strip_offsets.push_back(static_cast<index_type>(std::min(font.m_strip_vertices.size() / 2,BasicFont<T>::MAX_INDEX)));
+			for(const auto point : strip)
+			{
+				font.m_strip_vertices.push_back(points[point * 2]);
+				font.m_strip_vertices.push_back(points[point * 2 + 1]);
+			}
+			++glyph_strips.strip_count;
+		}
+
+		font.m_glyph_strips.push_back(glyph_strips);
+		joined.emplace(range.primitive_index,glyph_strips);
+	}
+
+	font.m_strip_offsets.push_back(static_cast<index_type>(std::min(font.m_strip_vertices.size() / 2,BasicFont<T>::MAX_INDEX)));
+	font.m_strip_vertices.shrink_to_fit();
+	font.m_strip_offsets.shrink_to_fit();
+	font.m_glyph_strips.shrink_to_fit();
+}
+
+//-----------------------------------------------------------------------------
+//	build
+//-----------------------------------------------------------------------------
+//	Finalizes the font: builds the code index, levels of detail and, if 
+//	enabled, polyline strips and shrinks the arrays to fit.
+//	The builder is left empty.
+//-----------------------------------------------------------------------------
+template<typename T>
+BasicFontPtr<T>
+BasicFontBuilder<T>::build()
+{
+	// The font object is allocated from its resource as well as its storage.
+	auto alloc = m_font.get_allocator();
+	BasicFontPtr<T> p_font(std::construct_at(alloc.template allocate_object<BasicFont<T>>(),std::move(m_font)));
+	m_font = BasicFont<T>(alloc);
+
+	p_font->m_parameters.shrink_to_fit();
+	p_font->m_primitives.shrink_to_fit();
+	p_font->m_glyph_codes.shrink_to_fit();
+	p_font->m_glyph_advances.shrink_to_fit();
+	p_font->m_glyph_ranges.shrink_to_fit();
+	p_font->m_glyph_rects.shrink_to_fit();
+	p_font->m_id.shrink_to_fit();
+	p_font->m_code_index.build(p_font->m_glyph_codes);
+	build_lods(*p_font);
+
+	if(m_b_strips)
+		build_strips(*p_font);
+	else
+	{
+		p_font->m_strip_vertices = decltype(p_font->m_strip_vertices)(p_font->get_allocator());
+		p_font->m_strip_offsets = decltype(p_font->m_strip_offsets)(p_font->get_allocator());
+		p_font->m_glyph_strips = decltype(p_font->m_glyph_strips)(p_font->get_allocator());
+	}
+	m_b_strips = false;
+
+	return p_font;
+}
+
+} // namespace vectorfont
+
+#endif // ! defined GUARD_ADE_VECTORFONT_BUILDER_H
@@ -0,0 +1,254 @@
+//=============================================================================
+//	FILE:					cache.h
+//	SYSTEM:
+//	DESCRIPTION:	Cache of glyph geometry pre-scaled to a pixel size.
+//-----------------------------------------------------------------------------
+//  COPYRIGHT:		(C)Copyright 2026 Adrian Purser. All Rights Reserved.
+//	LICENCE:
+//	MAINTAINER:		AJP - Adrian Purser <ade&arcadestuff.com>
+//	CREATED:			16-OCT-2026 Adrian Purser <ade&arcadestuff.com>
+//-----------------------------------------------------------------------------
+//	Text that is drawn repeatedly at the same size doesn't need to be scaled
+//	from font units every time. A ScaledFont holds the geometry of a font's
+//	glyphs multiplied by a scale and rounded to integers, along with the
+//	scaled advances and bounds. Glyphs are scaled on first use and, as the
+//	coordinates are already in the orientation of the target, drawing them 
+//	only requires translating them to the pen position. Font coordinates 
+//	point up; a scaled font created for a y-down target, such as a screen,
+//	flips them.
+//
+//	GlyphCache keeps a ScaledFont for each (font, scale, orientation) that it
+//	is asked for. Both may be used from several threads at once.
+//=============================================================================
+#ifndef GUARD_ADE_VECTORFONT_CACHE_H
+#define GUARD_ADE_VECTORFONT_CACHE_H
+
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <span>
+#include <array>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <utility>
+#include <tuple>
+#include "vectorfont.h"
+
+namespace vectorfont
+{
+
+struct ScaledGlyph
+{
+	std::vector<int32_t>								parameters;
+	std::span<const vectorfont::Primitive>	primitives;			// Refers to the primitives of the source font
+	vectorfont::Rectangle<int32_t>			rect;
+	int32_t															advance_x	= 0;
+};
+
+//-----------------------------------------------------------------------------
+//	BasicScaledFont
+//-----------------------------------------------------------------------------
+template<typename T>
+class BasicScaledFont
+{
+public:
+	using font_type 		= BasicFont<T>;
+	using callback_type	= std::function<bool(vectorfont::Primitive,std::span<const int32_t>)>;
+
+private:
+	std::shared_ptr<const font_type>								mp_font;
+	float																						m_scale;
+	bool																						m_b_y_down;
+	int32_t																					m_missing_adv_x;
+
+	std::unique_ptr<std::atomic<const ScaledGlyph *>[]>	m_glyphs;
+	mutable std::mutex															m_mutex;
+	mutable std::vector<std::unique_ptr<ScaledGlyph>>	m_storage;
+	mutable std::atomic<size_t>											m_memory_usage	= 0;
+
+	const ScaledGlyph *															build_glyph(index_type index) const;
+
+public:
+	inline BasicScaledFont(std::shared_ptr<const font_type> p_font, float scale, bool b_y_down = false);
+	BasicScaledFont(const BasicScaledFont &) = delete;
+	BasicScaledFont & operator=(const BasicScaledFont &) = delete;
+
+	const font_type &																font() const noexcept						{return *mp_font;}
+	float																						scale() const noexcept					{return m_scale;}
+	bool																						is_y_down() const noexcept			{return m_b_y_down;}
+	int32_t																					missing_adv_x() const noexcept	{return m_missing_adv_x;}
+	int32_t																					scale_value(float value) const noexcept	{return static_cast<int32_t>(std::lrint(value * m_scale));}
+
+	inline const ScaledGlyph *											glyph(uint32_t code) const;
+	size_t																					memory_usage() const noexcept		{return m_memory_usage.load(std::memory_order_relaxed);}
+
+	template<typename S, PrimitiveCallback<int32_t> F>	void	execute(const S& string, int32_t x, int32_t y, F && callback) const;
+};
+
+template<typename T>
+BasicScaledFont<T>::BasicScaledFont(std::shared_ptr<const font_type> p_font, float scale, bool b_y_down)
+	: mp_font(std::move(p_font))
+	, m_scale(scale)
+	, m_b_y_down(b_y_down)
+	, m_missing_adv_x(scale_value(static_cast<float>(mp_font->missing_adv_x())))
+	, m_glyphs(new std::atomic<const ScaledGlyph *>[mp_font->glyph_count()]())
+{
+	m_memory_usage = sizeof(*this) + mp_font->glyph_count() * sizeof(std::atomic<const ScaledGlyph *>);
+}
+
+//-----------------------------------------------------------------------------
+//	glyph
+//-----------------------------------------------------------------------------
+//	Returns the scaled glyph for a code or nullptr if the font doesn't have
+//	the glyph. The glyph is scaled the first time it is requested, later
+//	requests only load a pointer. The returned glyph lives as long as the
+//	scaled font.
+//-----------------------------------------------------------------------------
+template<typename T>
+const ScaledGlyph *
+BasicScaledFont<T>::glyph(uint32_t code) const
+{
+	const auto index = mp_font->glyph_index(code);
+	if(index == font_type::NO_GLYPH)
+		return nullptr;
+
+	const ScaledGlyph * p_glyph = m_glyphs[index].load(std::memory_order_acquire);
+	return p_glyph ? p_glyph : build_glyph(index);
+}
+
+template<typename T>
+const ScaledGlyph *
+BasicScaledFont<T>::build_glyph(index_type index) const
+{
+	std::lock_guard lock(m_mutex);
+
+	// Another thread may have built the glyph while we were waiting.
+	if(const ScaledGlyph * p_glyph = m_glyphs[index].load(std::memory_order_acquire); p_glyph)
+		return p_glyph;
+
+	const auto & range	= mp_font->glyph_ranges()[index];
+	auto p_glyph 				= std::make_unique<ScaledGlyph>();
+	p_glyph->primitives = mp_font->primitives().subspan(range.primitive_index,range.primitive_count);
+	p_glyph->advance_x	= scale_value(static_cast<float>(mp_font->glyph_advances()[index]));
+
+	size_t param_count = 0;
+	for(const auto primitive : p_glyph->primitives)
+		param_count += parameter_count(primitive);
+
+	// Parameters are x,y pairs so every second one is a y coordinate.
+	p_glyph->parameters.reserve(param_count);
+	for(const auto param : mp_font->parameters().subspan(range.parameter_index,param_count))
+	{
+		const bool b_flip = m_b_y_down && (p_glyph->parameters.size() & 1);
+		p_glyph->parameters.push_back(scale_value(b_flip ? -static_cast<float>(param) : static_cast<float>(param)));
+	}
+
+	for(size_t i = 0; (i + 1) < p_glyph->parameters.size(); i += 2)
+		p_glyph->rect.add(p_glyph->parameters[i],p_glyph->parameters[i + 1]);
+
+	m_memory_usage += sizeof(ScaledGlyph) + sizeof(std::unique_ptr<ScaledGlyph>) + param_count * sizeof(int32_t);
+
+	const ScaledGlyph * p_result = p_glyph.get();
+	m_storage.push_back(std::move(p_glyph));
+	m_glyphs[index].store(p_result,std::memory_order_release);
+	return p_result;
+}
+
+//-----------------------------------------------------------------------------
+//	execute
+//-----------------------------------------------------------------------------
+//	As BasicFont::execute() but the parameters are scaled and translated by
+//	the pen position, starting from x,y.  The ADVANCE command is passed the
+//	scaled advance.
+//-----------------------------------------------------------------------------
+template<typename T>
+template<typename S, PrimitiveCallback<int32_t> F>
+void
+BasicScaledFont<T>::execute(const S & string, int32_t x, int32_t y, F && callback) const
+{
+	std::array<int32_t,2> point;
+
+	for(uint32_t code : string)
+	{
+		const auto p_glyph = glyph(code);
+		if(p_glyph == nullptr)
+		{
+			callback(vectorfont::Primitive{vectorfont::command::ADVANCE},std::span<const int32_t>(&m_missing_adv_x,1));
+			x += m_missing_adv_x;
+			continue;
+		}
+
+		const int32_t * p_param = p_glyph->parameters.data();
+		for(const auto primitive : p_glyph->primitives)
+		{
+			const auto pcount = parameter_count(primitive);
+			if(pcount == 2)
+			{
+				point[0] = x + p_param[0];
+				point[1] = y + p_param[1];
+			}
+			p_param += pcount;
+			if(callback(primitive,std::span<const int32_t>(point.data(),pcount)))
+				break;
+		}
+		callback(vectorfont::Primitive{vectorfont::command::ADVANCE},std::span<const int32_t>(&p_glyph->advance_x,1));
+		x += p_glyph->advance_x;
+	}
+}
+
+//-----------------------------------------------------------------------------
+//	BasicGlyphCache
+//-----------------------------------------------------------------------------
+//	Scaled fonts are returned as shared pointers so that they remain valid
+//	if the cache is cleared while they are in use.
+//-----------------------------------------------------------------------------
+template<typename T>
+class BasicGlyphCache
+{
+public:
+	using font_type 				= BasicFont<T>;
+	using scaled_font_type	= BasicScaledFont<T>;
+
+private:
+	mutable std::mutex 																																m_mutex;
+	std::map<std::tuple<const font_type *,float,bool>,std::shared_ptr<const scaled_font_type>>	m_fonts;
+
+public:
+	inline std::shared_ptr<const scaled_font_type>		get(const std::shared_ptr<const font_type> & p_font, float scale, bool b_y_down = false);
+	inline std::shared_ptr<const scaled_font_type>		get_size(const std::shared_ptr<const font_type> & p_font, float pixel_size, bool b_y_down = false) {return get(p_font,p_font->units_per_em() ? pixel_size / static_cast<float>(p_font->units_per_em()) : 0.0f,b_y_down);}
+
+	inline size_t																			size() const											{std::lock_guard lock(m_mutex); return m_fonts.size();}
+	inline size_t																			memory_usage() const;
+	inline void																				clear()														{std::lock_guard lock(m_mutex); m_fonts.clear();}
+};
+
+using ScaledFont	= BasicScaledFont<int16_t>;
+using GlyphCache	= BasicGlyphCache<int16_t>;
+
+template<typename T>
+std::shared_ptr<const typename BasicGlyphCache<T>::scaled_font_type>
+BasicGlyphCache<T>::get(const std::shared_ptr<const font_type> & p_font, float scale, bool b_y_down)
+{
+	std::lock_guard lock(m_mutex);
+	auto & p_scaled = m_fonts[{p_font.get(),scale,b_y_down}];
+	if(!p_scaled)
+		p_scaled = std::make_shared<const scaled_font_type>(p_font,scale,b_y_down);
+	return p_scaled;
+}
+
+template<typename T>
+size_t
+BasicGlyphCache<T>::memory_usage() const
+{
+	std::lock_guard lock(m_mutex);
+	size_t total = 0;
+	for(const auto & [key,p_font] : m_fonts)
+		total += p_font->memory_usage();
+	return total;
+}
+
+} // namespace vectorfont
+
+#endif // ! defined GUARD_ADE_VECTORFONT_CACHE_H
@@ -0,0 +1,221 @@
+//=============================================================================
+//	FILE:					clip.h
+//	SYSTEM:
+//	DESCRIPTION:	Batch clipping of line segments.
+//-----------------------------------------------------------------------------
+//  COPYRIGHT:		(C)Copyright 2026 Adrian Purser. All Rights Reserved.
+//	LICENCE:
+//	MAINTAINER:		AJP - Adrian Purser <ade&arcadestuff.com>
+//	CREATED:			16-OCT-2026 Adrian Purser <ade&arcadestuff.com>
+//-----------------------------------------------------------------------------
+//	Clips the segments written by layout_segments() to a viewport using the
+//	Liang-Barsky algorithm, several segments at a time with SSE2 or AVX2.
+//	Segments that are completely outside of the viewport are removed and the
+//	remaining segments are compacted to the front of the buffers, keeping
+//	their order and caps. This can be used between layout and rasterization.
+//
+//	A clipped end keeps the segment's cap; as the end is on the edge of the
+//	viewport the cap is outside of it.
+//=============================================================================
+#ifndef GUARD_ADE_VECTORFONT_CLIP_H
+#define GUARD_ADE_VECTORFONT_CLIP_H
+
+#include <cstdint>
+#include <span>
+#include <algorithm>
+#include "layout.h"
+#include "transform.h"
+#include "cull.h"
+
+namespace vectorfont
+{
+
+namespace detail
+{
+
+//-----------------------------------------------------------------------------
+//	Clips a single segment. Returns false if the segment is rejected.
+//-----------------------------------------------------------------------------
+inline bool
+clip_segment(const Viewport & viewport, float & x0, float & y0, float & x1, float & y1) noexcept
+{
+	const float dx = x1 - x0;
+	const float dy = y1 - y0;
+	const float p[4] = {-dx, dx, -dy, dy};
+	const float q[4] = {x0 - viewport.left, viewport.right - x0, y0 - viewport.top, viewport.bottom - y0};
+	float t0 = 0.0f;
+	float t1 = 1.0f;
+
+	for(int edge = 0; edge < 4; ++edge)
+	{
+		if(p[edge] == 0.0f)
+		{
+			if(q[edge] < 0.0f)
+				return false;
+		}
+		else
+		{
+			const float r = q[edge] / p[edge];
+			if(p[edge] < 0.0f)
+				t0 = std::max(t0,r);
+			else
+				t1 = std::min(t1,r);
+		}
+	}
+
+	if(t0 > t1)
+		return false;
+
+	const float ox = x0;
+	const float oy = y0;
+	if(t0 > 0.0f)	{x0 = ox + t0 * dx; y0 = oy + t0 * dy;}
+	if(t1 < 1.0f)	{x1 = ox + t1 * dx; y1 = oy + t1 * dy;}
+	return true;
+}
+
+// Moves segment `from` to `to`, which must not be after it.
+inline void
+move_segment(const SegmentBuffers<float> & buffers, size_t from, size_t to, float x0, float y0, float x1, float y1) noexcept
+{
+	buffers.x0[to] = x0;
+	buffers.y0[to] = y0;
+	buffers.x1[to] = x1;
+	buffers.y1[to] = y1;
+	if((from != to) && (from < buffers.caps.size()))
+		buffers.caps[to] = buffers.caps[from];
+}
+
+#if defined(VECTORFONT_SSE2)
+inline __m128
+select(__m128 mask, __m128 a, __m128 b) noexcept		// mask ? a : b
+{
+	return _mm_or_ps(_mm_and_ps(mask,a),_mm_andnot_ps(mask,b));
+}
+#endif
+
+} // namespace detail
+
+//-----------------------------------------------------------------------------
+//	clip_segments
+//-----------------------------------------------------------------------------
+//	Clips the first count segments in the buffers to the viewport. Returns
+//	the number of segments that remain, which are at the front of the
+//	buffers.
+//-----------------------------------------------------------------------------
+inline size_t
+clip_segments(const SegmentBuffers<float> & buffers, size_t count, const Viewport & viewport) noexcept
+{
+	count = std::min(count,buffers.capacity());
+	size_t out = 0;
+	size_t i = 0;
+
+#if defined(VECTORFONT_AVX2)
+	{
+		const __m256 left 	= _mm256_set1_ps(viewport.left);
+		const __m256 right 	= _mm256_set1_ps(viewport.right);
+		const __m256 top 		= _mm256_set1_ps(viewport.top);
+		const __m256 bottom = _mm256_set1_ps(viewport.bottom);
+		const __m256 zero 	= _mm256_setzero_ps();
+		const __m256 one 		= _mm256_set1_ps(1.0f);
+
+		for(; (i + 8) <= count; i += 8)
+		{
+			const __m256 x0 = _mm256_loadu_ps(buffers.x0.data() + i);
+			const __m256 y0 = _mm256_loadu_ps(buffers.y0.data() + i);
+			const __m256 x1 = _mm256_loadu_ps(buffers.x1.data() + i);
+			const __m256 y1 = _mm256_loadu_ps(buffers.y1.data() + i);
+			const __m256 dx = _mm256_sub_ps(x1,x0);
+			const __m256 dy = _mm256_sub_ps(y1,y0);
+
+			const __m256 p[4] = {_mm256_sub_ps(zero,dx),dx,_mm256_sub_ps(zero,dy),dy};
+			const __m256 q[4] = {_mm256_sub_ps(x0,left),_mm256_sub_ps(right,x0),_mm256_sub_ps(y0,top),_mm256_sub_ps(bottom,y0)};
+			__m256 t0 			= zero;
+			__m256 t1 			= one;
+			__m256 reject 	= _mm256_setzero_ps();
+
+			for(int edge = 0; edge < 4; ++edge)
+			{
+				const __m256 r = _mm256_div_ps(q[edge],p[edge]);
+				t0 			= _mm256_blendv_ps(t0,_mm256_max_ps(t0,r),_mm256_cmp_ps(p[edge],zero,_CMP_LT_OQ));
+				t1 			= _mm256_blendv_ps(t1,_mm256_min_ps(t1,r),_mm256_cmp_ps(p[edge],zero,_CMP_GT_OQ));
+				reject 	= _mm256_or_ps(reject,_mm256_and_ps(_mm256_cmp_ps(p[edge],zero,_CMP_EQ_OQ),_mm256_cmp_ps(q[edge],zero,_CMP_LT_OQ)));
+			}
+			reject = _mm256_or_ps(reject,_mm256_cmp_ps(t0,t1,_CMP_GT_OQ));
+
+			alignas(32) float cx0[8], cy0[8], cx1[8], cy1[8];
+			_mm256_store_ps(cx0,_mm256_blendv_ps(x0,_mm256_add_ps(x0,_mm256_mul_ps(t0,dx)),_mm256_cmp_ps(t0,zero,_CMP_GT_OQ)));
+			_mm256_store_ps(cy0,_mm256_blendv_ps(y0,_mm256_add_ps(y0,_mm256_mul_ps(t0,dy)),_mm256_cmp_ps(t0,zero,_CMP_GT_OQ)));
+			_mm256_store_ps(cx1,_mm256_blendv_ps(x1,_mm256_add_ps(x0,_mm256_mul_ps(t1,dx)),_mm256_cmp_ps(t1,one,_CMP_LT_OQ)));
+			_mm256_store_ps(cy1,_mm256_blendv_ps(y1,_mm256_add_ps(y0,_mm256_mul_ps(t1,dy)),_mm256_cmp_ps(t1,one,_CMP_LT_OQ)));
+
+			const int rejected = _mm256_movemask_ps(reject);
+			for(int lane = 0; lane < 8; ++lane)
+				if(!(rejected & (1 << lane)))
+					detail::move_segment(buffers,i + lane,out++,cx0[lane],cy0[lane],cx1[lane],cy1[lane]);
+		}
+	}
+#endif
+
+#if defined(VECTORFONT_SSE2)
+	{
+		const __m128 left 	= _mm_set1_ps(viewport.left);
+		const __m128 right 	= _mm_set1_ps(viewport.right);
+		const __m128 top 		= _mm_set1_ps(viewport.top);
+		const __m128 bottom = _mm_set1_ps(viewport.bottom);
+		const __m128 zero 	= _mm_setzero_ps();
+		const __m128 one 		= _mm_set1_ps(1.0f);
+
+		for(; (i + 4) <= count; i += 4)
+		{
+			const __m128 x0 = _mm_loadu_ps(buffers.x0.data() + i);
+			const __m128 y0 = _mm_loadu_ps(buffers.y0.data() + i);
+			const __m128 x1 = _mm_loadu_ps(buffers.x1.data() + i);
+			const __m128 y1 = _mm_loadu_ps(buffers.y1.data() + i);
+			const __m128 dx = _mm_sub_ps(x1,x0);
+			const __m128 dy = _mm_sub_ps(y1,y0);
+
+			const __m128 p[4] = {_mm_sub_ps(zero,dx),dx,_mm_sub_ps(zero,dy),dy};
+			const __m128 q[4] = {_mm_sub_ps(x0,left),_mm_sub_ps(right,x0),_mm_sub_ps(y0,top),_mm_sub_ps(bottom,y0)};
+			__m128 t0 			= zero;
+			__m128 t1 			= one;
+			__m128 reject 	= _mm_setzero_ps();
+
+			for(int edge = 0; edge < 4; ++edge)
+			{
+				const __m128 r = _mm_div_ps(q[edge],p[edge]);
+				t0 			= detail::select(_mm_cmplt_ps(p[edge],zero),_mm_max_ps(t0,r),t0);
+				t1 			= detail::select(_mm_cmpgt_ps(p[edge],zero),_mm_min_ps(t1,r),t1);
+				reject 	= _mm_or_ps(reject,_mm_and_ps(_mm_cmpeq_ps(p[edge],zero),_mm_cmplt_ps(q[edge],zero)));
+			}
+			reject = _mm_or_ps(reject,_mm_cmpgt_ps(t0,t1));
+
+			alignas(16) float cx0[4], cy0[4], cx1[4], cy1[4];
+			_mm_store_ps(cx0,detail::select(_mm_cmpgt_ps(t0,zero),_mm_add_ps(x0,_mm_mul_ps(t0,dx)),x0));
+			_mm_store_ps(cy0,detail::select(_mm_cmpgt_ps(t0,zero),_mm_add_ps(y0,_mm_mul_ps(t0,dy)),y0));
+			_mm_store_ps(cx1,detail::select(_mm_cmplt_ps(t1,one),_mm_add_ps(x0,_mm_mul_ps(t1,dx)),x1));
+			_mm_store_ps(cy1,detail::select(_mm_cmplt_ps(t1,one),_mm_add_ps(y0,_mm_mul_ps(t1,dy)),y1));
+
+			const int rejected = _mm_movemask_ps(reject);
+			for(int lane = 0; lane < 4; ++lane)
+				if(!(rejected & (1 << lane)))
+					detail::move_segment(buffers,i + lane,out++,cx0[lane],cy0[lane],cx1[lane],cy1[lane]);
+		}
+	}
+#endif
+
+	for(; i < count; ++i)
+	{
+		float x0 = buffers.x0[i];
+		float y0 = buffers.y0[i];
+		float x1 = buffers.x1[i];
+		float y1 = buffers.y1[i];
+		if(detail::clip_segment(viewport,x0,y0,x1,y1))
+			detail::move_segment(buffers,i,out++,x0,y0,x1,y1);
+	}
+
+	return out;
+}
+
+} // namespace vectorfont
+
+#endif // ! defined GUARD_ADE_VECTORFONT_CLIP_H
@@ -0,0 +1,344 @@
+//=============================================================================
+//	FILE:					compressed.h
+//	SYSTEM:
+//	DESCRIPTION:	Compressed Stroked Vector Font Structure
+//-----------------------------------------------------------------------------
+//  COPYRIGHT:		(C)Copyright 2026 Adrian Purser. All Rights Reserved.
+//	LICENCE:
+//	MAINTAINER:		AJP - Adrian Purser <ade&arcadestuff.com>
+//	CREATED:			16-OCT-2026 Adrian Purser <ade&arcadestuff.com>
+//-----------------------------------------------------------------------------
+//	Each glyph is stored as a byte stream, found through a table of offsets.
+//	The stream starts with the glyph's advance and rectangle, as zigzag
+//	varints, followed by its primitives. The glyph codes are only kept in the
+//	code index.
+//
+//	The primitives are encoded as the deltas dx,dy from the previous point in
+//	the glyph, the first point of a glyph is relative to the origin. Most
+//	Hershey strokes are short round capped lines, which encode to one byte:
+//
+//		0 - 120		LINETO, ROUND cap, dx = byte / 11 - 5, dy = byte % 11 - 5
+//
+//	Any other primitive is a byte holding the command and cap followed by the
+//	deltas as zigzag varints:
+//
+//		0x80 | (cap << 1) | (command == LINETO), zigzag(dx), zigzag(dy)
+//=============================================================================
+#ifndef GUARD_ADE_VECTORFONT_COMPRESSED_H
+#define GUARD_ADE_VECTORFONT_COMPRESSED_H
+
+#include <cstdint>
+#include <vector>
+#include <array>
+#include <span>
+#include <string>
+#include <string_view>
+#include <memory_resource>
+#include <type_traits>
+#include "vectorfont.h"
+
+namespace vectorfont
+{
+
+template<typename T>
+class BasicCompressedFont
+{
+	static_assert(std::is_integral_v<T>,"Compressed fonts require an integral coordinate type");
+
+public:
+	using coord_type			= T;
+	using rect_type				= vectorfont::Rectangle<T>;
+	using pen_type				= typename BasicFont<T>::pen_type;
+	using callback_type		= typename BasicFont<T>::callback_type;
+	using allocator_type	= std::pmr::polymorphic_allocator<std::byte>;
+
+	static constexpr index_type					NO_GLYPH			= GlyphIndex::NO_GLYPH;
+
+private:
+	std::pmr::vector<uint8_t>						m_stream;
+	std::pmr::vector<uint32_t>					m_glyph_offsets;			// Byte offset of each glyph in the stream plus an end offset.
+	vectorfont::GlyphIndex							m_code_index;
+	rect_type														m_rect;
+
+	std::pmr::string										m_id;
+
+	int16_t															m_ascent 				= 0;
+	int16_t															m_descent				= 0;
+	int16_t															m_units_per_em 	= 0;
+	T																		m_missing_adv_x	= 0;
+
+	inline const uint8_t *							read_glyph_header(index_type index, pen_type & advance, Rectangle<pen_type> & rect) const noexcept;
+
+public:
+	BasicCompressedFont() = default;
+	explicit inline BasicCompressedFont(const BasicFont<T> & font, const allocator_type & alloc = {});
+
+	allocator_type															get_allocator() const noexcept	{return m_stream.get_allocator();}
+
+	std::span<const uint8_t>										stream() const noexcept					{return m_stream;}
+	std::span<const uint32_t>										glyph_offsets() const noexcept	{return m_glyph_offsets;}
+	const vectorfont::GlyphIndex &							code_index() const noexcept			{return m_code_index;}
+	const rect_type &														rect() const noexcept						{return m_rect;}
+	std::string_view														id() const noexcept							{return m_id;}
+	int16_t																			ascent() const noexcept					{return m_ascent;}
+	int16_t																			descent() const noexcept				{return m_descent;}
+	int16_t																			units_per_em() const noexcept		{return m_units_per_em;}
+	const T &																		missing_adv_x() const noexcept	{return m_missing_adv_x;}
+
+	size_t																			glyph_count() const noexcept	{return m_glyph_offsets.empty() ? 0 : m_glyph_offsets.size() - 1;}
+	index_type																	glyph_index(uint32_t code) const noexcept {return m_code_index.find(code);}
+	inline pen_type															glyph_advance(index_type index) const noexcept;
+	inline Rectangle<pen_type>									glyph_rect(index_type index) const noexcept;
+	inline MemoryUsage													memory_usage() const noexcept;
+
+	template<typename S, PrimitiveCallback<T> F>	void	execute(const S& string, F && callback) const;
+	template<PrimitiveCallback<T> F>	void						execute(uint32_t code, F && callback) const;
+	inline void																	execute(uint32_t code, const callback_type & callback) const	{execute<const callback_type &>(code,callback);}
+
+	template<typename S>	Rectangle<pen_type>		string_rect(const S& string) const;
+};
+
+using CompressedFont = BasicCompressedFont<int16_t>;
+
+namespace detail
+{
+
+inline constexpr int32_t	SHORT_DELTA			= 5;						// Largest delta of a one byte LINETO
+inline constexpr uint8_t	SHORT_LINETO_END	= 121;				// (2 * SHORT_DELTA + 1) squared
+inline constexpr uint8_t	LONG_PRIMITIVE		= 0x80;
+
+template<typename C>
+void
+write_varint(C & stream, uint32_t value)
+{
+	while(value >= 0x80)
+	{
+		stream.push_back(static_cast<uint8_t>(value | 0x80));
+		value >>= 7;
+	}
+	stream.push_back(static_cast<uint8_t>(value));
+}
+
+inline uint32_t
+read_varint(const uint8_t *& p_data) noexcept
+{
+	uint32_t value = 0;
+	int shift = 0;
+	uint8_t byte;
+	do
+	{
+		byte = *p_data++;
+		value |= uint32_t{byte & 0x7Fu} << shift;
+		shift += 7;
+	} while(byte & 0x80);
+	return value;
+}
+
+constexpr uint32_t	zigzag_encode(int32_t value) noexcept		{return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);}
+constexpr int32_t		zigzag_decode(uint32_t value) noexcept	{return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);}
+
+} // namespace detail
+
+//-----------------------------------------------------------------------------
+//	The compressed font's storage is allocated from the memory resource of
+//	the allocator.
+//-----------------------------------------------------------------------------
+template<typename T>
+BasicCompressedFont<T>::BasicCompressedFont(const BasicFont<T> & font, const allocator_type & alloc)
+	: m_stream(alloc)
+	, m_glyph_offsets(alloc)
+	, m_code_index(alloc)
+	, m_rect(font.rect())
+	, m_id(font.id(),alloc)
+	, m_ascent(font.ascent())
+	, m_descent(font.descent())
+	, m_units_per_em(font.units_per_em())
+	, m_missing_adv_x(font.missing_adv_x())
+{
+	m_glyph_offsets.reserve(font.glyph_count() + 1);
+
+	for(size_t index = 0; index < font.glyph_count(); ++index)
+	{
+		m_glyph_offsets.push_back(static_cast<uint32_t>(m_stream.size()));
+
+		const auto & grect = font.glyph_rects()[index];
+		detail::write_varint(m_stream,detail::zigzag_encode(font.glyph_advances()[index]));
+		detail::write_varint(m_stream,detail::zigzag_encode(grect.left));
+		detail::write_varint(m_stream,detail::zigzag_encode(grect.top));
+		detail::write_varint(m_stream,detail::zigzag_encode(grect.right));
+		detail::write_varint(m_stream,detail::zigzag_encode(grect.bottom));
+
+		const auto & range = font.glyph_ranges()[index];
+		int32_t x = 0;
+		int32_t y = 0;
+		auto param_index = range.parameter_index;
+
+		for(index_type i = 0; i < range.primitive_count; ++i)
+		{
+			const auto primitive = font.primitives()[range.primitive_index + i];
+			if(parameter_count(primitive) != 2)
+				continue;
+
+			const int32_t px = font.parameters()[param_index++];
+			const int32_t py = font.parameters()[param_index++];
+			const int32_t dx = px - x;
+			const int32_t dy = py - y;
+			const bool b_lineto = primitive.command == vectorfont::command::LINETO;
+
+			if(	b_lineto && (primitive.cap == vectorfont::cap::ROUND) &&
+					(dx >= -detail::SHORT_DELTA) && (dx <= detail::SHORT_DELTA) &&
+					(dy >= -detail::SHORT_DELTA) && (dy <= detail::SHORT_DELTA))
+				m_stream.push_back(static_cast<uint8_t>((dx + detail::SHORT_DELTA) * (2 * detail::SHORT_DELTA + 1) + dy + detail::SHORT_DELTA));
+			else
+			{
+				m_stream.push_back(static_cast<uint8_t>(detail::LONG_PRIMITIVE | (primitive.cap << 1) | (b_lineto ? 1 : 0)));
+				detail::write_varint(m_stream,detail::zigzag_encode(dx));
+				detail::write_varint(m_stream,detail::zigzag_encode(dy));
+			}
+			x = px;
+			y = py;
+		}
+	}
+
+	m_glyph_offsets.push_back(static_cast<uint32_t>(m_stream.size()));
+	m_stream.shrink_to_fit();
+	m_code_index.build(font.glyph_codes());
+}
+
+//-----------------------------------------------------------------------------
+//	Reads the advance and rectangle of a glyph and returns the start of its
+//	primitives.
+//-----------------------------------------------------------------------------
+template<typename T>
+const uint8_t *
+BasicCompressedFont<T>::read_glyph_header(index_type index, pen_type & advance, Rectangle<pen_type> & rect) const noexcept
+{
+	const uint8_t * p_data = m_stream.data() + m_glyph_offsets[index];
+	advance 		= detail::zigzag_decode(detail::read_varint(p_data));
+	rect.left		= detail::zigzag_decode(detail::read_varint(p_data));
+	rect.top		= detail::zigzag_decode(detail::read_varint(p_data));
+	rect.right	= detail::zigzag_decode(detail::read_varint(p_data));
+	rect.bottom	= detail::zigzag_decode(detail::read_varint(p_data));
+	return p_data;
+}
+
+template<typename T>
+typename BasicCompressedFont<T>::pen_type
+BasicCompressedFont<T>::glyph_advance(index_type index) const noexcept
+{
+	const uint8_t * p_data = m_stream.data() + m_glyph_offsets[index];
+	return detail::zigzag_decode(detail::read_varint(p_data));
+}
+
+template<typename T>
+Rectangle<typename BasicCompressedFont<T>::pen_type>
+BasicCompressedFont<T>::glyph_rect(index_type index) const noexcept
+{
+	pen_type advance;
+	Rectangle<pen_type> rect;
+	read_glyph_header(index,advance,rect);
+	return rect;
+}
+
+//-----------------------------------------------------------------------------
+//	The primitives and their parameters are interleaved in the stream with
+//	the glyph advances and rectangles, so they are all reported as
+//	primitives.
+//-----------------------------------------------------------------------------
+template<typename T>
+MemoryUsage
+BasicCompressedFont<T>::memory_usage() const noexcept
+{
+	MemoryUsage usage;
+	usage.glyphs 			= detail::allocated_bytes(m_glyph_offsets);
+	usage.primitives	= detail::allocated_bytes(m_stream);
+	usage.index				= m_code_index.memory_usage();
+	usage.other				= sizeof(*this) + m_id.capacity();
+	return usage;
+}
+
+template<typename T>
+template<typename S, PrimitiveCallback<T> F>
+void
+BasicCompressedFont<T>::execute(const S & string, F && callback) const
+{
+	for(uint32_t code : string)
+		execute(code,callback);
+}
+
+template<typename T>
+template<PrimitiveCallback<T> F>
+void
+BasicCompressedFont<T>::execute(uint32_t code, F && callback) const
+{
+	const auto index = glyph_index(code);
+	if(index != NO_GLYPH)
+	{
+		pen_type advance;
+		Rectangle<pen_type> rect;
+		const uint8_t * p_data 	= read_glyph_header(index,advance,rect);
+		const uint8_t * p_end		= m_stream.data() + m_glyph_offsets[index + 1];
+		int32_t x = 0;
+		int32_t y = 0;
+
+		while(p_data < p_end)
+		{
+			vectorfont::Primitive primitive;
+			const auto header = *p_data++;
+			if(header < detail::SHORT_LINETO_END)
+			{
+				x += header / (2 * detail::SHORT_DELTA + 1) - detail::SHORT_DELTA;
+				y += header % (2 * detail::SHORT_DELTA + 1) - detail::SHORT_DELTA;
+				primitive.command = vectorfont::command::LINETO;
+				primitive.cap			= vectorfont::cap::ROUND;
+			}
+			else
+			{
+				x += detail::zigzag_decode(detail::read_varint(p_data));
+				y += detail::zigzag_decode(detail::read_varint(p_data));
+				primitive.command = (header & 1) ? vectorfont::command::LINETO : vectorfont::command::MOVETO;
+				primitive.cap			= (header >> 1) & 3;
+			}
+
+			const std::array<T,2> params{static_cast<T>(x),static_cast<T>(y)};
+			if(callback(primitive,std::span<const T>{params}))
+				break;
+		}
+
+		const T adv_x = static_cast<T>(advance);
+		callback(vectorfont::Primitive{vectorfont::command::ADVANCE},std::span<const T>{&adv_x,1});
+	}
+	else
+		callback(vectorfont::Primitive{vectorfont::command::ADVANCE},std::span<const T>{&m_missing_adv_x,1});
+}
+
+template<typename T>
+template<typename S>
+Rectangle<typename BasicCompressedFont<T>::pen_type>
+BasicCompressedFont<T>::string_rect(const S& string) const
+{
+	Rectangle<pen_type> rect;
+	pen_type x = 0;
+
+	for(uint32_t code : string)
+	{
+		const auto index = glyph_index(code);
+		if(index != NO_GLYPH)
+		{
+			pen_type advance;
+			Rectangle<pen_type> grect;
+			read_glyph_header(index,advance,grect);
+			grect.move_relative(x,0);
+			rect.add(grect);
+			x += advance;
+		}
+		else
+			x += m_missing_adv_x;
+	}
+
+	return rect;
+}
+
+} // namespace vectorfont
+
+#endif // ! defined GUARD_ADE_VECTORFONT_COMPRESSED_H
@@ -0,0 +1,182 @@
+//=============================================================================
+//	FILE:					cull.h
+//	SYSTEM:
+//	DESCRIPTION:	Viewport culling of glyphs.
+//-----------------------------------------------------------------------------
+//  COPYRIGHT:		(C)Copyright 2026 Adrian Purser. All Rights Reserved.
+//	LICENCE:
+//	MAINTAINER:		AJP - Adrian Purser <ade&arcadestuff.com>
+//	CREATED:			16-OCT-2026 Adrian Purser <ade&arcadestuff.com>
+//-----------------------------------------------------------------------------
+//	Transformed execution and layout that skip glyphs whose transformed
+//	bounds are outside of a viewport, and stop once the pen has moved past
+//	the viewport for good. Only whole glyphs are culled; the primitives of a
+//	glyph that overlaps the viewport are all emitted.
+//
+//	The viewport is in output coordinates with left <= right and top <=
+//	bottom. The glyph bounds don't include the width of the stroke, so the
+//	viewport should be expanded by half the line width. The early exit
+//	assumes that advances are not negative.
+//=============================================================================
+#ifndef GUARD_ADE_VECTORFONT_CULL_H
+#define GUARD_ADE_VECTORFONT_CULL_H
+
+#include <cstdint>
+#include <array>
+#include <span>
+#include <algorithm>
+#include "vectorfont.h"
+#include "layout.h"
+#include "transform.h"
+
+namespace vectorfont
+{
+
+using Viewport = vectorfont::Rectangle<float>;
+
+namespace detail
+{
+
+// Returns the bounds of a rectangle after it has been transformed.
+template<typename R>
+Viewport
+transform_rect(const Affine & affine, const R & rect) noexcept
+{
+	const std::array<float,4> xs{static_cast<float>(rect.left),static_cast<float>(rect.right),static_cast<float>(rect.left),static_cast<float>(rect.right)};
+	const std::array<float,4> ys{static_cast<float>(rect.top),static_cast<float>(rect.top),static_cast<float>(rect.bottom),static_cast<float>(rect.bottom)};
+
+	Viewport bounds;
+	bounds.left 	= bounds.right 	= affine.map_x(xs[0],ys[0]);
+	bounds.top 		= bounds.bottom = affine.map_y(xs[0],ys[0]);
+	for(size_t i = 1; i < 4; ++i)
+		bounds.add(affine.map_x(xs[i],ys[i]),affine.map_y(xs[i],ys[i]));
+	return bounds;
+}
+
+inline bool
+overlaps(const Viewport & a, const Viewport & b) noexcept
+{
+	return (a.left <= b.right) && (a.right >= b.left) && (a.top <= b.bottom) && (a.bottom >= b.top);
+}
+
+//-----------------------------------------------------------------------------
+//	Returns true if the font's bounds, placed anywhere from the pen position
+//	onwards, are outside of the viewport. The pen moves along (a,b) so once
+//	the bounds are beyond an edge in that direction no later glyph can be
+//	visible.
+//-----------------------------------------------------------------------------
+inline bool
+past_viewport(const Affine & affine, const Viewport & font_bounds, const Viewport & viewport) noexcept
+{
+	return	((affine.a > 0.0f) && (font_bounds.left > viewport.right))
+				||	((affine.a < 0.0f) && (font_bounds.right < viewport.left))
+				||	((affine.b > 0.0f) && (font_bounds.top > viewport.bottom))
+				||	((affine.b < 0.0f) && (font_bounds.bottom < viewport.top));
+}
+
+//-----------------------------------------------------------------------------
+//	Calls fn(index,pen_x) for each code in the string whose glyph overlaps the
+//	viewport and fn(NO_GLYPH,pen_x) for codes without a glyph. Stops when fn
+//	returns false or no more glyphs can be visible. Returns the number of
+//	codes that were processed.
+//-----------------------------------------------------------------------------
+template<typename T, typename S, typename F>
+size_t
+for_each_visible_glyph(const BasicFont<T> & font, const S & string, const Affine & affine, const Viewport & viewport, F && fn)
+{
+	typename BasicFont<T>::pen_type pen_x = 0;
+	size_t count = 0;
+
+	for(uint32_t code : string)
+	{
+		const Affine glyph_affine = affine * Affine::translation(static_cast<float>(pen_x),0.0f);
+		if(past_viewport(affine,transform_rect(glyph_affine,font.rect()),viewport))
+			break;
+
+		const auto index = font.glyph_index(code);
+		if(index != BasicFont<T>::NO_GLYPH)
+		{
+			if(overlaps(transform_rect(glyph_affine,font.glyph_rects()[index]),viewport) && !fn(index,pen_x))
+				break;
+			pen_x += font.glyph_advances()[index];
+		}
+		else
+		{
+			if(!fn(BasicFont<T>::NO_GLYPH,pen_x))
+				break;
+			pen_x += font.missing_adv_x();
+		}
+		++count;
+	}
+
+	return count;
+}
+
+} // namespace detail
+
+//-----------------------------------------------------------------------------
+//	execute_culled
+//-----------------------------------------------------------------------------
+//	As execute_transformed() but glyphs outside of the viewport are skipped.
+//	A PEN_POSITION is only passed for the glyphs that are executed and for
+//	missing glyphs. Returns the number of codes that were processed before
+//	the pen passed the viewport.
+//-----------------------------------------------------------------------------
+template<typename O = float, typename T, typename S, typename F>
+	requires PrimitiveCallback<F,O>
+size_t
+execute_culled(const BasicFont<T> & font, const S & string, const Affine & affine, const Viewport & viewport, F && callback)
+{
+	std::array<O,detail::TRANSFORM_BLOCK> buffer;
+
+	return detail::for_each_visible_glyph(font,string,affine,viewport,[&](index_type index, auto pen_x)
+		{
+			if(index != BasicFont<T>::NO_GLYPH)
+			{
+				detail::execute_transformed_glyph(font,index,affine * Affine::translation(static_cast<float>(pen_x),0.0f),buffer,callback);
+				pen_x += font.glyph_advances()[index];
+			}
+			else
+				pen_x += font.missing_adv_x();
+
+			detail::execute_transformed_advance<O>(affine,static_cast<float>(pen_x),callback);
+			return true;
+		});
+}
+
+//-----------------------------------------------------------------------------
+//	layout_segments_culled
+//-----------------------------------------------------------------------------
+//	As layout_segments() with a transform, but only the glyphs that overlap
+//	the viewport are written. The returned codes are the number of codes
+//	that were processed.
+//-----------------------------------------------------------------------------
+template<typename T, typename S>
+LayoutSize
+layout_segments_culled(const BasicFont<T> & font, const S & string, const SegmentBuffers<float> & buffers, const Affine & affine, const Viewport & viewport)
+{
+	LayoutSize size;
+	const auto capacity = buffers.capacity();
+
+	size.codes = detail::for_each_visible_glyph(font,string,affine,viewport,[&](index_type index, auto pen_x)
+		{
+			if(index == BasicFont<T>::NO_GLYPH)
+				return true;
+
+			const auto first = size.segments;
+			if(!detail::glyph_segments_fit(font,index,first,capacity))
+				return false;
+
+			size.segments = detail::layout_glyph_segments(font,index,static_cast<float>(pen_x),0.0f,buffers,first);
+			const auto count = size.segments - first;
+			transform_points(affine,buffers.x0.subspan(first,count),buffers.y0.subspan(first,count));
+			transform_points(affine,buffers.x1.subspan(first,count),buffers.y1.subspan(first,count));
+			return true;
+		});
+
+	return size;
+}
+
+} // namespace vectorfont
+
+#endif // ! defined GUARD_ADE_VECTORFONT_CULL_H
@@ -0,0 +1,175 @@
+//=============================================================================
+//	FILE:					cursor.h
+//	SYSTEM:
+//	DESCRIPTION:	Resumable, budgeted execution of a text run.
+//-----------------------------------------------------------------------------
+//  COPYRIGHT:		(C)Copyright 2026 Adrian Purser. All Rights Reserved.
+//	LICENCE:
+//	MAINTAINER:		AJP - Adrian Purser <ade&arcadestuff.com>
+//	CREATED:			16-OCT-2026 Adrian Purser <ade&arcadestuff.com>
+//-----------------------------------------------------------------------------
+//	A RenderCursor walks the primitives of a text run on demand. It can be
+//	stepped a limited number of primitives or for a limited time and then
+//	resumed later, e.g. on the next frame, from exactly where it stopped. This
+//	allows a long block of text to be drawn over several frames.
+//
+//	Unlike Font::execute(), a callback that returns true suspends the cursor
+//	after that primitive rather than skipping the rest of the glyph.
+//=============================================================================
+#ifndef GUARD_ADE_VECTORFONT_CURSOR_H
+#define GUARD_ADE_VECTORFONT_CURSOR_H
+
+#include <cstdint>
+#include <span>
+#include <chrono>
+#include <memory>
+#include <utility>
+#include "vectorfont.h"
+#include "run.h"
+
+namespace vectorfont
+{
+
+template<typename T>
+class BasicRenderCursor
+{
+public:
+	using font_type = BasicFont<T>;
+	using run_type	= BasicTextRun<T>;
+
+	static constexpr size_t	CLOCK_INTERVAL = 16;		// Primitives executed between checks of the clock
+
+private:
+	run_type			m_run;
+	size_t				m_position	= 0;		// Character in the run
+	index_type		m_primitive	= 0;		// Primitive in the current glyph
+	size_t				m_parameter = 0;		// Parameter of the current primitive
+
+	inline void		start_character() noexcept;
+
+public:
+	explicit BasicRenderCursor(run_type run) : m_run(std::move(run)) {start_character();}
+	template<typename S> BasicRenderCursor(std::shared_ptr<const font_type> p_font, const S & string) : BasicRenderCursor(run_type(std::move(p_font),string)) {}
+
+	const run_type &		run() const noexcept				{return m_run;}
+	size_t							position() const noexcept		{return m_position;}
+	bool								done() const noexcept				{return m_position >= m_run.size();}
+	void								reset() noexcept						{m_position = 0; start_character();}
+
+	inline bool					next(vectorfont::Primitive & primitive, std::span<const T> & parameters) noexcept;
+
+	template<PrimitiveCallback<T> F>	size_t	step(size_t max_primitives, F && callback);
+	template<typename Rep, typename Period, PrimitiveCallback<T> F>	size_t	step_for(std::chrono::duration<Rep,Period> budget, F && callback);
+};
+
+using RenderCursor = BasicRenderCursor<int16_t>;
+
+template<typename T>
+void
+BasicRenderCursor<T>::start_character() noexcept
+{
+	m_primitive = 0;
+	if(!done())
+	{
+		const auto index = m_run.glyphs()[m_position];
+		if(index != font_type::NO_GLYPH)
+			m_parameter = m_run.font().glyph_ranges()[index].parameter_index;
+	}
+}
+
+//-----------------------------------------------------------------------------
+//	next
+//-----------------------------------------------------------------------------
+//	Returns the next primitive and its parameters. Each character ends with an
+//	ADVANCE. Returns false once the whole run has been executed.
+//-----------------------------------------------------------------------------
+template<typename T>
+bool
+BasicRenderCursor<T>::next(vectorfont::Primitive & primitive, std::span<const T> & parameters) noexcept
+{
+	if(done())
+		return false;
+
+	const auto & font = m_run.font();
+	const auto index 	= m_run.glyphs()[m_position];
+
+	if(index != font_type::NO_GLYPH)
+	{
+		const auto & range = font.glyph_ranges()[index];
+		if(m_primitive < range.primitive_count)
+		{
+			primitive 	= font.primitives()[range.primitive_index + m_primitive++];
+			parameters 	= font.parameters().subspan(m_parameter,parameter_count(primitive));
+			m_parameter += parameters.size();
+			return true;
+		}
+		parameters = font.glyph_advances().subspan(index,1);
+	}
+	else
+		parameters = std::span<const T>(&font.missing_adv_x(),1);
+
+	primitive = vectorfont::Primitive{vectorfont::command::ADVANCE};
+	++m_position;
+	start_character();
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+//	step
+//-----------------------------------------------------------------------------
+//	Executes up to max_primitives primitives, stopping early if the callback
+//	returns true. Returns the number of primitives executed.
+//-----------------------------------------------------------------------------
+template<typename T>
+template<PrimitiveCallback<T> F>
+size_t
+BasicRenderCursor<T>::step(size_t max_primitives, F && callback)
+{
+	vectorfont::Primitive primitive;
+	std::span<const T> parameters;
+	size_t count = 0;
+
+	while((count < max_primitives) && next(primitive,parameters))
+	{
+		++count;
+		if(callback(primitive,parameters))
+			break;
+	}
+
+	return count;
+}
+
+//-----------------------------------------------------------------------------
+//	step_for
+//-----------------------------------------------------------------------------
+//	Executes primitives until the time budget has been used, the run has been
+//	executed or the callback returns true. The clock is only read every
+//	CLOCK_INTERVAL primitives so the budget may be exceeded by up to that
+//	many primitives. Returns the number of primitives executed.
+//-----------------------------------------------------------------------------
+template<typename T>
+template<typename Rep, typename Period, PrimitiveCallback<T> F>
+size_t
+BasicRenderCursor<T>::step_for(std::chrono::duration<Rep,Period> budget, F && callback)
+{
+	const auto deadline = std::chrono::steady_clock::now() + budget;
+	bool b_stop = false;
+	size_t count = 0;
+
+	auto stop_callback = [&](vectorfont::Primitive primitive, std::span<const T> parameters)
+	{
+		b_stop = callback(primitive,parameters);
+		return b_stop;
+	};
+
+	do
+	{
+		count += step(CLOCK_INTERVAL,stop_callback);
+	} while(!b_stop && !done() && (std::chrono::steady_clock::now() < deadline));
+
+	return count;
+}
+
+} // namespace vectorfont
+
+#endif // ! defined GUARD_ADE_VECTORFONT_CURSOR_H
@@ -15,13 +15,39 @@
 #include <string_view>
 #include <optional>
 #include <memory>
+#include <memory_resource>
 #include "vectorfont.h"
 
 namespace vectorfont
 {
 
-std::unique_ptr<vectorfont::Font>		parse_hershey_font(const std::string_view src);
-std::unique_ptr<vectorfont::Font>		load_hershey_font(std::string_view filename);
+// The coordinate type of the font can be selected with the template parameter.
+// Loading fails if the font's coordinates do not fit in the type. The loader
+// is instantiated for int8_t, int16_t and float.
+// The font, the file buffer, the XML document and the temporary storage
+// used while building the font are all allocated from the memory resource.
+template<typename T = int16_t>	vectorfont::BasicFontPtr<T>		parse_hershey_font(const std::string_view src, std::pmr::memory_resource * p_resource = std::pmr::get_default_resource());
+template<typename T = int16_t>	vectorfont::BasicFontPtr<T>		load_hershey_font(std::string_view filename, std::pmr::memory_resource * p_resource = std::pmr::get_default_resource());
+
+// Coordinates are stored as absolute values, so a font with more units per 
+// em than the type can hold, e.g. in int8_t, can be rescaled to units_per_em
+// units per em while it is loaded. The metrics, advances and coordinates are
+// scaled and, for integral types, rounded to the nearest unit.
+template<typename T = int16_t>	vectorfont::BasicFontPtr<T>		parse_hershey_font_scaled(const std::string_view src, int16_t units_per_em, std::pmr::memory_resource * p_resource = std::pmr::get_default_resource());
+template<typename T = int16_t>	vectorfont::BasicFontPtr<T>		load_hershey_font_scaled(std::string_view filename, int16_t units_per_em, std::pmr::memory_resource * p_resource = std::pmr::get_default_resource());
+
+extern template vectorfont::BasicFontPtr<int8_t>		parse_hershey_font<int8_t>(const std::string_view src, std::pmr::memory_resource * p_resource);
+extern template vectorfont::BasicFontPtr<int16_t>		parse_hershey_font<int16_t>(const std::string_view src, std::pmr::memory_resource * p_resource);
+extern template vectorfont::BasicFontPtr<float>		parse_hershey_font<float>(const std::string_view src, std::pmr::memory_resource * p_resource);
+extern template vectorfont::BasicFontPtr<int8_t>		load_hershey_font<int8_t>(std::string_view filename, std::pmr::memory_resource * p_resource);
+extern template vectorfont::BasicFontPtr<int16_t>		load_hershey_font<int16_t>(std::string_view filename, std::pmr::memory_resource * p_resource);
+extern template vectorfont::BasicFontPtr<float>		load_hershey_font<float>(std::string_view filename, std::pmr::memory_resource * p_resource);
+extern template vectorfont::BasicFontPtr<int8_t>		parse_hershey_font_scaled<int8_t>(const std::string_view src, int16_t units_per_em, std::pmr::memory_resource * p_resource);
+extern template vectorfont::BasicFontPtr<int16_t>		parse_hershey_font_scaled<int16_t>(const std::string_view src, int16_t units_per_em, std::pmr::memory_resource * p_resource);
+extern template vectorfont::BasicFontPtr<float>		parse_hershey_font_scaled<float>(const std::string_view src, int16_t units_per_em, std::pmr::memory_resource * p_resource);
+extern template vectorfont::BasicFontPtr<int8_t>		load_hershey_font_scaled<int8_t>(std::string_view filename, int16_t units_per_em, std::pmr::memory_resource * p_resource);
+extern template vectorfont::BasicFontPtr<int16_t>		load_hershey_font_scaled<int16_t>(std::string_view filename, int16_t units_per_em, std::pmr::memory_resource * p_resource);
+extern template vectorfont::BasicFontPtr<float>		load_hershey_font_scaled<float>(std::string_view filename, int16_t units_per_em, std::pmr::memory_resource * p_resource);
 
 } // namespace vectorfont
 
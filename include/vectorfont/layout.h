@@ -0,0 +1,375 @@
+//=============================================================================
+//	FILE:					layout.h
+//	SYSTEM:
+//	DESCRIPTION:	Bulk output of the geometry of a string.
+//-----------------------------------------------------------------------------
+//  COPYRIGHT:		(C)Copyright 2026 Adrian Purser. All Rights Reserved.
+//	LICENCE:
+//	MAINTAINER:		AJP - Adrian Purser <ade&arcadestuff.com>
+//	CREATED:			16-OCT-2026 Adrian Purser <ade&arcadestuff.com>
+//-----------------------------------------------------------------------------
+//	Lays out a whole string and writes its strokes into caller supplied
+//	structure of arrays buffers, either as individual line segments or as
+//	polylines. The coordinates are absolute, i.e. the pen position and the
+//	origin have been added. Nothing is allocated; layout_size() reports the
+//	size of the buffers that are required for a string.
+//
+//	If the buffers are too small then only the glyphs that fit completely are
+//	written and the returned counts show how much of the string was laid out.
+//
+//	layout_instances() writes a record per glyph instead, for renderers that
+//	draw each glyph as an instance of geometry that is uploaded once from
+//	BasicFont::geometry().
+//=============================================================================
+#ifndef GUARD_ADE_VECTORFONT_LAYOUT_H
+#define GUARD_ADE_VECTORFONT_LAYOUT_H
+
+#include <cstdint>
+#include <span>
+#include <algorithm>
+#include <type_traits>
+#include "vectorfont.h"
+
+namespace vectorfont
+{
+
+//-----------------------------------------------------------------------------
+//	Output buffers. Segment i is the line from (x0[i],y0[i]) to (x1[i],y1[i]).
+//	The caps buffer is optional and receives the line cap of each segment.
+//-----------------------------------------------------------------------------
+template<typename P>
+struct SegmentBuffers
+{
+	std::span<P>				x0;
+	std::span<P>				y0;
+	std::span<P>				x1;
+	std::span<P>				y1;
+	std::span<uint8_t>	caps	= {};
+
+	size_t	capacity() const noexcept	{return std::min({x0.size(),y0.size(),x1.size(),y1.size()});}
+};
+
+//-----------------------------------------------------------------------------
+//	Polyline i is made of the vertices from run_offsets[i] up to, but not
+//	including, run_offsets[i+1], so run_offsets must have one more entry than
+//	the number of runs.
+//-----------------------------------------------------------------------------
+template<typename P>
+struct PolylineBuffers
+{
+	std::span<P>				x;
+	std::span<P>				y;
+	std::span<uint32_t>	run_offsets;
+
+	size_t	capacity() const noexcept	{return std::min(x.size(),y.size());}
+};
+
+//-----------------------------------------------------------------------------
+//	A glyph drawn with its origin at x,y and scaled by scale, i.e. a point
+//	px,py of the glyph is drawn at (x + px * scale, y + py * scale).
+//-----------------------------------------------------------------------------
+struct GlyphInstance
+{
+	index_type	glyph_index;
+	float				x;
+	float				y;
+	float				scale;
+};
+
+struct LayoutSize
+{
+	size_t		codes			= 0;		// Number of codes from the string that were laid out
+	size_t		segments	= 0;
+	size_t		vertices	= 0;
+	size_t		runs			= 0;		// Number of polylines
+	size_t		instances	= 0;		// Number of glyphs with geometry
+};
+
+namespace detail
+{
+
+template<typename T>
+LayoutSize
+glyph_layout_size(const BasicFont<T> & font, index_type index)
+{
+	LayoutSize size;
+	const auto & range = font.glyph_ranges()[index];
+	bool b_open = false;
+
+	for(const auto primitive : font.primitives().subspan(range.primitive_index,range.primitive_count))
+	{
+		if(primitive.command == vectorfont::command::MOVETO)
+			b_open = false;
+		else if(primitive.command == vectorfont::command::LINETO)
+		{
+			++size.segments;
+			++size.vertices;
+			if(!b_open)
+			{
+				++size.vertices;
+				++size.runs;
+				b_open = true;
+			}
+		}
+	}
+
+	return size;
+}
+
+//-----------------------------------------------------------------------------
+//	Returns true if the segments of a glyph fit in the capacity after used
+//	segments. A glyph has at most one segment per primitive, so its segments
+//	are only counted when it is near the end of the buffers.
+//-----------------------------------------------------------------------------
+template<typename T>
+bool
+glyph_segments_fit(const BasicFont<T> & font, index_type index, size_t used, size_t capacity)
+{
+	return 	((used + font.glyph_ranges()[index].primitive_count) <= capacity) ||
+					((used + glyph_layout_size(font,index).segments) <= capacity);
+}
+
+//-----------------------------------------------------------------------------
+//	Writes the segments of a glyph at x,y into the buffers, starting at
+//	segment. The buffers must have space for the glyph. Returns the new number
+//	of segments.
+//-----------------------------------------------------------------------------
+template<typename T, typename X, typename P>
+size_t
+layout_glyph_segments(const BasicFont<T> & font, index_type index, X origin_x, P origin_y, const SegmentBuffers<P> & buffers, size_t segment)
+{
+	const auto	params 			= font.parameters();
+	const auto & range 			= font.glyph_ranges()[index];
+	auto 				param_index = range.parameter_index;
+	P cx = static_cast<P>(origin_x);
+	P cy = origin_y;
+
+	for(const auto primitive : font.primitives().subspan(range.primitive_index,range.primitive_count))
+	{
+		if(parameter_count(primitive) != 2)
+			continue;
+
+		const P x = static_cast<P>(origin_x + params[param_index]);
+		const P y = static_cast<P>(origin_y + params[param_index + 1]);
+		param_index += 2;
+
+		if(primitive.command == vectorfont::command::LINETO)
+		{
+			buffers.x0[segment] = cx;
+			buffers.y0[segment] = cy;
+			buffers.x1[segment] = x;
+			buffers.y1[segment] = y;
+			if(segment < buffers.caps.size())
+				buffers.caps[segment] = primitive.cap;
+			++segment;
+		}
+		cx = x;
+		cy = y;
+	}
+
+	return segment;
+}
+
+} // namespace detail
+
+//-----------------------------------------------------------------------------
+//	layout_size
+//-----------------------------------------------------------------------------
+//	Returns the number of segments, polyline vertices and polyline runs that
+//	the string lays out to.
+//-----------------------------------------------------------------------------
+template<typename T, typename S>
+LayoutSize
+layout_size(const BasicFont<T> & font, const S & string)
+{
+	LayoutSize size;
+
+	for(uint32_t code : string)
+	{
+		++size.codes;
+		const auto index = font.glyph_index(code);
+		if(index == BasicFont<T>::NO_GLYPH)
+			continue;
+
+		const auto glyph_size = detail::glyph_layout_size(font,index);
+		size.segments += glyph_size.segments;
+		size.vertices += glyph_size.vertices;
+		size.runs			+= glyph_size.runs;
+		size.instances += (font.glyph_ranges()[index].primitive_count > 0);
+	}
+
+	return size;
+}
+
+//-----------------------------------------------------------------------------
+//	layout_segments
+//-----------------------------------------------------------------------------
+//	Writes the strokes of the string as line segments. Returns the number of
+//	codes and segments that were written.
+//-----------------------------------------------------------------------------
+template<typename T, typename S, typename P>
+LayoutSize
+layout_segments(const BasicFont<T> & font, const S & string, const SegmentBuffers<P> & buffers, std::type_identity_t<P> origin_x = 0, std::type_identity_t<P> origin_y = 0)
+{
+	using pen_type = typename BasicFont<T>::pen_type;
+
+	LayoutSize	size;
+	const auto	capacity 	= buffers.capacity();
+	pen_type		pen_x 		= 0;
+
+	for(uint32_t code : string)
+	{
+		const auto index = font.glyph_index(code);
+		if(index == BasicFont<T>::NO_GLYPH)
+		{
+			pen_x += font.missing_adv_x();
+			++size.codes;
+			continue;
+		}
+
+		if(!detail::glyph_segments_fit(font,index,size.segments,capacity))
+			break;
+
+		size.segments = detail::layout_glyph_segments(font,index,origin_x + pen_x,origin_y,buffers,size.segments);
+		pen_x += font.glyph_advances()[index];
+		++size.codes;
+	}
+
+	return size;
+}
+
+//-----------------------------------------------------------------------------
+//	layout_polylines
+//-----------------------------------------------------------------------------
+//	Writes the strokes of the string as polylines. Each MOVETO followed by
+//	one or more LINETOs becomes a run of vertices. Returns the number of
+//	codes, vertices and runs that were written.
+//-----------------------------------------------------------------------------
+template<typename T, typename S, typename P>
+LayoutSize
+layout_polylines(const BasicFont<T> & font, const S & string, const PolylineBuffers<P> & buffers, std::type_identity_t<P> origin_x = 0, std::type_identity_t<P> origin_y = 0)
+{
+	using pen_type = typename BasicFont<T>::pen_type;
+
+	LayoutSize	size;
+	const auto	capacity 	= buffers.capacity();
+	const auto	params 		= font.parameters();
+	pen_type		pen_x 		= 0;
+
+	if(buffers.run_offsets.empty())
+		return size;
+
+	buffers.run_offsets[0] = 0;
+
+	for(uint32_t code : string)
+	{
+		const auto index = font.glyph_index(code);
+		if(index == BasicFont<T>::NO_GLYPH)
+		{
+			pen_x += font.missing_adv_x();
+			++size.codes;
+			continue;
+		}
+
+		// A glyph has at most one vertex per primitive plus the start of its
+		// first run, and at most one run per primitive. Its vertices and runs
+		// are only counted when it is near the end of the buffers.
+		const auto & range 	= font.glyph_ranges()[index];
+		if(((size.vertices + range.primitive_count + 1) > capacity) || ((size.runs + range.primitive_count) >= buffers.run_offsets.size()))
+		{
+			const auto glyph_size = detail::glyph_layout_size(font,index);
+			if(((size.vertices + glyph_size.vertices) > capacity) || ((size.runs + glyph_size.runs) >= buffers.run_offsets.size()))
+				break;
+		}
+
+		auto param_index 		= range.parameter_index;
+		P cx = static_cast<P>(origin_x + pen_x);
+		P cy = origin_y;
+		bool b_open = false;
+
+		for(const auto primitive : font.primitives().subspan(range.primitive_index,range.primitive_count))
+		{
+			if(parameter_count(primitive) != 2)
+				continue;
+
+			const P x = static_cast<P>(origin_x + pen_x + params[param_index]);
+			const P y = static_cast<P>(origin_y + params[param_index + 1]);
+			param_index += 2;
+
+			if(primitive.command == vectorfont::command::MOVETO)
+			{
+				if(b_open)
+					buffers.run_offsets[++size.runs] = static_cast<uint32_t>(size.vertices);
+				b_open = false;
+			}
+			else
+			{
+				if(!b_open)
+				{
+					buffers.x[size.vertices] = cx;
+					buffers.y[size.vertices] = cy;
+					++size.vertices;
+					b_open = true;
+				}
+				buffers.x[size.vertices] = x;
+				buffers.y[size.vertices] = y;
+				++size.vertices;
+			}
+			cx = x;
+			cy = y;
+		}
+
+		if(b_open)
+			buffers.run_offsets[++size.runs] = static_cast<uint32_t>(size.vertices);
+
+		pen_x += font.glyph_advances()[index];
+		++size.codes;
+	}
+
+	return size;
+}
+
+//-----------------------------------------------------------------------------
+//	layout_instances
+//-----------------------------------------------------------------------------
+//	Writes an instance for each glyph in the string that has geometry; codes
+//	without a glyph and glyphs without geometry only move the pen. The pen
+//	advances are multiplied by scale. Returns the number of codes and
+//	instances that were written.
+//-----------------------------------------------------------------------------
+template<typename T, typename S>
+LayoutSize
+layout_instances(const BasicFont<T> & font, const S & string, std::span<GlyphInstance> instances, float origin_x = 0.0f, float origin_y = 0.0f, float scale = 1.0f)
+{
+	using pen_type = typename BasicFont<T>::pen_type;
+
+	LayoutSize	size;
+	pen_type		pen_x = 0;
+
+	for(uint32_t code : string)
+	{
+		const auto index = font.glyph_index(code);
+		if(index == BasicFont<T>::NO_GLYPH)
+		{
+			pen_x += font.missing_adv_x();
+			++size.codes;
+			continue;
+		}
+
+		if(font.glyph_ranges()[index].primitive_count > 0)
+		{
+			if(size.instances >= instances.size())
+				break;
+			instances[size.instances++] = GlyphInstance{index,origin_x + static_cast<float>(pen_x) * scale,origin_y,scale};
+		}
+
+		pen_x += font.glyph_advances()[index];
+		++size.codes;
+	}
+
+	return size;
+}
+
+} // namespace vectorfont
+
+#endif // ! defined GUARD_ADE_VECTORFONT_LAYOUT_H
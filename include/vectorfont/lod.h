@@ -0,0 +1,99 @@
+//=============================================================================
+//	FILE:					lod.h
+//	SYSTEM:
+//	DESCRIPTION:	Level of detail selection and greeking.
+//-----------------------------------------------------------------------------
+//  COPYRIGHT:		(C)Copyright 2026 Adrian Purser. All Rights Reserved.
+//	LICENCE:
+//	MAINTAINER:		AJP - Adrian Purser <ade&arcadestuff.com>
+//	CREATED:			16-OCT-2026 Adrian Purser <ade&arcadestuff.com>
+//-----------------------------------------------------------------------------
+//	Fonts can hold simplified levels of detail, generated by
+//	BasicFontBuilder::set_lod_tolerances(). execute_lod() picks the simplest
+//	level whose error is below a fraction of a pixel at the size being drawn.
+//	Text that is smaller than the greeking size is drawn as a single bar
+//	across the middle of each glyph's bounds.
+//=============================================================================
+#ifndef GUARD_ADE_VECTORFONT_LOD_H
+#define GUARD_ADE_VECTORFONT_LOD_H
+
+#include <cstdint>
+#include <span>
+#include <array>
+#include "vectorfont.h"
+
+namespace vectorfont
+{
+
+struct LodOptions
+{
+	float		max_error		= 0.5f;			// Largest simplification error allowed, in pixels
+	float		greek_size	= 4.0f;			// Text smaller than this, in pixels per em, is greeked
+};
+
+//-----------------------------------------------------------------------------
+//	select_lod
+//-----------------------------------------------------------------------------
+//	Returns the level of detail to draw the font at for a size in pixels per
+//	em.
+//-----------------------------------------------------------------------------
+template<typename T>
+size_t
+select_lod(const BasicFont<T> & font, float pixel_size, const LodOptions & options = {}) noexcept
+{
+	if((font.units_per_em() <= 0) || (pixel_size <= 0.0f))
+		return 0;
+
+	const float scale = pixel_size / static_cast<float>(font.units_per_em());
+	size_t level = 0;
+	while(((level + 1) < font.lod_count()) && ((font.lod_tolerance(level + 1) * scale) <= options.max_error))
+		++level;
+	return level;
+}
+
+//-----------------------------------------------------------------------------
+//	execute_lod
+//-----------------------------------------------------------------------------
+//	As BasicFont::execute() but the geometry is taken from the level of detail
+//	for the size, in pixels per em, that the text will be drawn at. Below the
+//	greeking size each glyph with geometry is executed as a MOVETO and LINETO
+//	across the middle of its bounds.
+//-----------------------------------------------------------------------------
+template<typename T, typename S, PrimitiveCallback<T> F>
+void
+execute_lod(const BasicFont<T> & font, const S & string, float pixel_size, F && callback, const LodOptions & options = {})
+{
+	if(pixel_size >= options.greek_size)
+	{
+		const auto level = select_lod(font,pixel_size,options);
+		for(uint32_t code : string)
+			font.execute_glyph(font.glyph_index(code),callback,level);
+		return;
+	}
+
+	for(uint32_t code : string)
+	{
+		const auto index = font.glyph_index(code);
+		if((index != BasicFont<T>::NO_GLYPH) && (font.glyph_ranges()[index].primitive_count > 0))
+		{
+			const auto & rect = font.glyph_rects()[index];
+			const T middle 		= static_cast<T>((rect.top + rect.bottom) / 2);
+			const std::array<T,2> from{rect.left,middle};
+			const std::array<T,2> to{rect.right,middle};
+
+			vectorfont::Primitive primitive;
+			primitive.command = vectorfont::command::MOVETO;
+			primitive.cap			= vectorfont::cap::ROUND;
+			callback(primitive,std::span<const T>(from));
+			primitive.command = vectorfont::command::LINETO;
+			callback(primitive,std::span<const T>(to));
+		}
+
+		const auto & advance = (index != BasicFont<T>::NO_GLYPH) ? font.glyph_advances()[index] : font.missing_adv_x();
+		callback(vectorfont::Primitive{vectorfont::command::ADVANCE},std::span<const T>(&advance,1));
+	}
+}
+
+} // namespace vectorfont
+
+#endif // ! defined GUARD_ADE_VECTORFONT_LOD_H
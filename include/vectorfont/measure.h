@@ -0,0 +1,308 @@
+//=============================================================================
+//	FILE:					measure.h
+//	SYSTEM:
+//	DESCRIPTION:	Fast measurement of strings.
+//-----------------------------------------------------------------------------
+//  COPYRIGHT:		(C)Copyright 2026 Adrian Purser. All Rights Reserved.
+//	LICENCE:
+//	MAINTAINER:		AJP - Adrian Purser <ade&arcadestuff.com>
+//	CREATED:			16-OCT-2026 Adrian Purser <ade&arcadestuff.com>
+//-----------------------------------------------------------------------------
+//	Width-only measurement, which layout engines need far more often than
+//	bounds. measure_width() only sums advances and doesn't touch the glyph
+//	bounds. It looks up the glyphs of a block of characters and then sums
+//	their advances, with an AVX2 gather for int16_t fonts when it is
+//	available. measure_bounds() returns the same rectangle as
+//	BasicFont::string_rect() but resolves a block of characters at a time
+//	and folds the minimum and maximum of the block's glyph bounds with SSE2
+//	or AVX2.
+//=============================================================================
+#ifndef GUARD_ADE_VECTORFONT_MEASURE_H
+#define GUARD_ADE_VECTORFONT_MEASURE_H
+
+#include <cstdint>
+#include <span>
+#include <array>
+#include <algorithm>
+#include <type_traits>
+#include "vectorfont.h"
+#include "transform.h"
+
+namespace vectorfont
+{
+
+namespace detail
+{
+
+inline constexpr size_t MEASURE_BLOCK = 64;
+
+#if defined(VECTORFONT_AVX2)
+inline int32_t
+horizontal_min(__m256i value) noexcept
+{
+	__m128i fold = _mm_min_epi32(_mm256_castsi256_si128(value),_mm256_extracti128_si256(value,1));
+	fold = _mm_min_epi32(fold,_mm_shuffle_epi32(fold,_MM_SHUFFLE(1,0,3,2)));
+	fold = _mm_min_epi32(fold,_mm_shuffle_epi32(fold,_MM_SHUFFLE(2,3,0,1)));
+	return _mm_cvtsi128_si32(fold);
+}
+
+inline int32_t
+horizontal_max(__m256i value) noexcept
+{
+	__m128i fold = _mm_max_epi32(_mm256_castsi256_si128(value),_mm256_extracti128_si256(value,1));
+	fold = _mm_max_epi32(fold,_mm_shuffle_epi32(fold,_MM_SHUFFLE(1,0,3,2)));
+	fold = _mm_max_epi32(fold,_mm_shuffle_epi32(fold,_MM_SHUFFLE(2,3,0,1)));
+	return _mm_cvtsi128_si32(fold);
+}
+
+inline int32_t
+horizontal_sum(__m256i value) noexcept
+{
+	__m128i fold = _mm_add_epi32(_mm256_castsi256_si128(value),_mm256_extracti128_si256(value,1));
+	fold = _mm_add_epi32(fold,_mm_shuffle_epi32(fold,_MM_SHUFFLE(1,0,3,2)));
+	fold = _mm_add_epi32(fold,_mm_shuffle_epi32(fold,_MM_SHUFFLE(2,3,0,1)));
+	return _mm_cvtsi128_si32(fold);
+}
+#endif
+
+#if defined(VECTORFONT_SSE2)
+// SSE2 has no 32 bit integer min and max, they are made from a compare.
+template<bool B_MAX>
+inline __m128i
+select_epi32(__m128i a, __m128i b) noexcept
+{
+	const __m128i mask = B_MAX ? _mm_cmpgt_epi32(a,b) : _mm_cmplt_epi32(a,b);
+	return _mm_or_si128(_mm_and_si128(mask,a),_mm_andnot_si128(mask,b));
+}
+
+// Folds the values from 0 to vec_end, which is a multiple of 4, into initial.
+template<bool B_MAX, typename P>
+P
+fold_sse2(std::span<const P> values, size_t vec_end, P initial) noexcept
+{
+	alignas(16) std::array<P,4> lanes;
+
+	if constexpr(std::is_same_v<P,float>)
+	{
+		__m128 result = _mm_set1_ps(initial);
+		for(size_t i = 0; i < vec_end; i += 4)
+			result = B_MAX ? _mm_max_ps(result,_mm_loadu_ps(values.data() + i)) : _mm_min_ps(result,_mm_loadu_ps(values.data() + i));
+		_mm_store_ps(lanes.data(),result);
+	}
+	else
+	{
+		__m128i result = _mm_set1_epi32(initial);
+		for(size_t i = 0; i < vec_end; i += 4)
+			result = select_epi32<B_MAX>(result,_mm_loadu_si128(reinterpret_cast<const __m128i *>(values.data() + i)));
+		_mm_store_si128(reinterpret_cast<__m128i *>(lanes.data()),result);
+	}
+
+	return B_MAX ? std::max({lanes[0],lanes[1],lanes[2],lanes[3]}) : std::min({lanes[0],lanes[1],lanes[2],lanes[3]});
+}
+#endif
+
+// Returns the smallest of the values and initial.
+template<typename P>
+P
+fold_min(std::span<const P> values, P initial) noexcept
+{
+	size_t vec_end = 0;
+#if defined(VECTORFONT_AVX2)
+	if constexpr(std::is_same_v<P,int32_t>)
+	{
+		vec_end = values.size() & ~size_t{7};
+		if(vec_end)
+		{
+			__m256i result = _mm256_set1_epi32(initial);
+			for(size_t i = 0; i < vec_end; i += 8)
+				result = _mm256_min_epi32(result,_mm256_loadu_si256(reinterpret_cast<const __m256i *>(values.data() + i)));
+			initial = horizontal_min(result);
+		}
+	}
+	else
+#endif
+#if defined(VECTORFONT_SSE2)
+	if constexpr(std::is_same_v<P,int32_t> || std::is_same_v<P,float>)
+	{
+		vec_end = values.size() & ~size_t{3};
+		if(vec_end)
+			initial = fold_sse2<false>(values,vec_end,initial);
+	}
+#endif
+	for(size_t i = vec_end; i < values.size(); ++i)
+		initial = std::min(initial,values[i]);
+	return initial;
+}
+
+// Returns the largest of the values and initial.
+template<typename P>
+P
+fold_max(std::span<const P> values, P initial) noexcept
+{
+	size_t vec_end = 0;
+#if defined(VECTORFONT_AVX2)
+	if constexpr(std::is_same_v<P,int32_t>)
+	{
+		vec_end = values.size() & ~size_t{7};
+		if(vec_end)
+		{
+			__m256i result = _mm256_set1_epi32(initial);
+			for(size_t i = 0; i < vec_end; i += 8)
+				result = _mm256_max_epi32(result,_mm256_loadu_si256(reinterpret_cast<const __m256i *>(values.data() + i)));
+			initial = horizontal_max(result);
+		}
+	}
+	else
+#endif
+#if defined(VECTORFONT_SSE2)
+	if constexpr(std::is_same_v<P,int32_t> || std::is_same_v<P,float>)
+	{
+		vec_end = values.size() & ~size_t{3};
+		if(vec_end)
+			initial = fold_sse2<true>(values,vec_end,initial);
+	}
+#endif
+	for(size_t i = vec_end; i < values.size(); ++i)
+		initial = std::max(initial,values[i]);
+	return initial;
+}
+
+// Returns the sum of the advances of the glyph indices. The indices must all
+// be valid. The loop has no branches so, other than the AVX2 gather of
+// int16_t advances, it is left to the compiler to vectorise.
+template<typename P, typename T>
+P
+sum_advances(std::span<const T> advances, std::span<const int32_t> indices) noexcept
+{
+	P sum = 0;
+	size_t vec_end = 0;
+#if defined(VECTORFONT_AVX2)
+	if constexpr(std::is_same_v<T,int16_t>)
+	{
+		// Each lane gathers the 32 bits at its advance and keeps the low 16.
+		// The last advance is taken from the source instead so that the
+		// gather doesn't read past the end of the advances.
+		vec_end = indices.size() & ~size_t{7};
+		if(vec_end)
+		{
+			const auto * 	p_base 			= reinterpret_cast<const int *>(advances.data());
+			const __m256i	last_index 	= _mm256_set1_epi32(static_cast<int32_t>(advances.size() - 1));
+			const __m256i	last 				= _mm256_set1_epi32(advances.back());
+			const __m256i	ones 				= _mm256_set1_epi32(-1);
+			__m256i result = _mm256_setzero_si256();
+			for(size_t i = 0; i < vec_end; i += 8)
+			{
+				const __m256i index	= _mm256_loadu_si256(reinterpret_cast<const __m256i *>(indices.data() + i));
+				const __m256i mask 	= _mm256_xor_si256(_mm256_cmpeq_epi32(index,last_index),ones);
+				const __m256i value	= _mm256_mask_i32gather_epi32(last,p_base,index,mask,2);
+				result = _mm256_add_epi32(result,_mm256_srai_epi32(_mm256_slli_epi32(value,16),16));
+			}
+			sum = horizontal_sum(result);
+		}
+	}
+#endif
+	for(size_t i = vec_end; i < indices.size(); ++i)
+		sum += advances[indices[i]];
+	return sum;
+}
+
+} // namespace detail
+
+//-----------------------------------------------------------------------------
+//	measure_width
+//-----------------------------------------------------------------------------
+//	Returns the sum of the advances of the string. The glyph indices of a
+//	block of characters are looked up first and their advances are then
+//	summed in a separate loop. Missing glyphs are summed as glyph 0 and
+//	corrected afterwards, so the sum doesn't branch.
+//-----------------------------------------------------------------------------
+template<typename T, typename S>
+typename BasicFont<T>::pen_type
+measure_width(const BasicFont<T> & font, const S & string)
+{
+	using pen_type = typename BasicFont<T>::pen_type;
+
+	const auto advances = font.glyph_advances();
+	std::array<int32_t,detail::MEASURE_BLOCK> indices;
+	pen_type width 	= 0;
+	size_t missing 	= 0;
+	size_t count 		= 0;
+
+	if(advances.empty())
+	{
+		for([[maybe_unused]] uint32_t code : string)
+			width += font.missing_adv_x();
+		return width;
+	}
+
+	for(uint32_t code : string)
+	{
+		const auto index 			= font.glyph_index(code);
+		const bool b_missing 	= (index == BasicFont<T>::NO_GLYPH);
+		missing += b_missing;
+		indices[count] = b_missing ? 0 : static_cast<int32_t>(index);
+		if(++count == detail::MEASURE_BLOCK)
+		{
+			width += detail::sum_advances<pen_type>(advances,std::span<const int32_t>(indices));
+			count = 0;
+		}
+	}
+
+	width += detail::sum_advances<pen_type>(advances,std::span<const int32_t>(indices).first(count));
+	return width + static_cast<pen_type>(missing) * (static_cast<pen_type>(font.missing_adv_x()) - static_cast<pen_type>(advances[0]));
+}
+
+//-----------------------------------------------------------------------------
+//	measure_bounds
+//-----------------------------------------------------------------------------
+//	Returns the bounds of the string, which include the origin, as
+//	BasicFont::string_rect().
+//-----------------------------------------------------------------------------
+template<typename T, typename S>
+Rectangle<typename BasicFont<T>::pen_type>
+measure_bounds(const BasicFont<T> & font, const S & string)
+{
+	using pen_type = typename BasicFont<T>::pen_type;
+
+	std::array<pen_type,detail::MEASURE_BLOCK> left, top, right, bottom;
+	Rectangle<pen_type> rect;
+	pen_type pen_x = 0;
+	size_t count = 0;
+
+	auto fold_block = [&]
+	{
+		rect.left 	= detail::fold_min(std::span<const pen_type>(left).first(count),rect.left);
+		rect.top 		= detail::fold_min(std::span<const pen_type>(top).first(count),rect.top);
+		rect.right 	= detail::fold_max(std::span<const pen_type>(right).first(count),rect.right);
+		rect.bottom = detail::fold_max(std::span<const pen_type>(bottom).first(count),rect.bottom);
+		count = 0;
+	};
+
+	// Missing glyphs have no bounds and are skipped, the origin is already in
+	// the rectangle.
+	for(uint32_t code : string)
+	{
+		const auto index = font.glyph_index(code);
+		if(index == BasicFont<T>::NO_GLYPH)
+		{
+			pen_x += font.missing_adv_x();
+			continue;
+		}
+
+		const auto & grect = font.glyph_rects()[index];
+		left[count] 	= grect.left + pen_x;
+		right[count] 	= grect.right + pen_x;
+		top[count] 		= grect.top;
+		bottom[count] = grect.bottom;
+		pen_x += font.glyph_advances()[index];
+		if(++count == detail::MEASURE_BLOCK)
+			fold_block();
+	}
+
+	fold_block();
+	return rect;
+}
+
+} // namespace vectorfont
+
+#endif // ! defined GUARD_ADE_VECTORFONT_MEASURE_H
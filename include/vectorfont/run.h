@@ -0,0 +1,141 @@
+//=============================================================================
+//	FILE:					run.h
+//	SYSTEM:
+//	DESCRIPTION:	Pre-resolved runs of text.
+//-----------------------------------------------------------------------------
+//  COPYRIGHT:		(C)Copyright 2026 Adrian Purser. All Rights Reserved.
+//	LICENCE:
+//	MAINTAINER:		AJP - Adrian Purser <ade&arcadestuff.com>
+//	CREATED:			16-OCT-2026 Adrian Purser <ade&arcadestuff.com>
+//-----------------------------------------------------------------------------
+//	A TextRun resolves a string against a font once, storing the glyph index
+//	and pen position of each character and the bounds of the whole string.
+//	Drawing, measuring and hit testing a run doesn't look up any codes.
+//
+//	The run refers to the font's geometry rather than copying it and keeps the
+//	font alive through a shared pointer. The resolved data is immutable and
+//	shared between copies, so runs are cheap to copy and may be used from
+//	several threads.
+//=============================================================================
+#ifndef GUARD_ADE_VECTORFONT_RUN_H
+#define GUARD_ADE_VECTORFONT_RUN_H
+
+#include <cstdint>
+#include <vector>
+#include <span>
+#include <memory>
+#include <algorithm>
+#include "vectorfont.h"
+
+namespace vectorfont
+{
+
+template<typename T>
+class BasicTextRun
+{
+public:
+	using font_type = BasicFont<T>;
+	using pen_type 	= typename font_type::pen_type;
+
+private:
+	struct Data
+	{
+		std::vector<index_type>		glyphs;					// Glyph index of each character, NO_GLYPH if missing
+		std::vector<pen_type>			pen_x;					// Pen position before each character plus the end position
+		Rectangle<pen_type>				rect;
+	};
+
+	std::shared_ptr<const font_type>		mp_font;
+	std::shared_ptr<const Data>					mp_data;
+
+public:
+	BasicTextRun() = default;
+	template<typename S> BasicTextRun(std::shared_ptr<const font_type> p_font, const S & string);
+
+	bool																	empty() const noexcept		{return !mp_data || mp_data->glyphs.empty();}
+	size_t																size() const noexcept			{return mp_data ? mp_data->glyphs.size() : 0;}
+	const font_type &											font() const noexcept			{return *mp_font;}
+	const std::shared_ptr<const font_type> &	font_ptr() const noexcept	{return mp_font;}
+
+	std::span<const index_type>						glyphs() const noexcept		{return mp_data ? std::span<const index_type>(mp_data->glyphs) : std::span<const index_type>();}
+	std::span<const pen_type>							pen_x() const noexcept		{return mp_data ? std::span<const pen_type>(mp_data->pen_x) : std::span<const pen_type>();}
+	pen_type															width() const noexcept		{return mp_data ? mp_data->pen_x.back() : pen_type{};}
+	Rectangle<pen_type>										rect() const noexcept			{return mp_data ? mp_data->rect : Rectangle<pen_type>{};}
+
+	inline size_t													hit_test(pen_type x) const noexcept;
+
+	template<PrimitiveCallback<T> F>	void	execute(F && callback) const;
+	template<FontVisitor<T> V>	void				visit(V & visitor) const;
+};
+
+using TextRun = BasicTextRun<int16_t>;
+
+template<typename T>
+template<typename S>
+BasicTextRun<T>::BasicTextRun(std::shared_ptr<const font_type> p_font, const S & string)
+	: mp_font(std::move(p_font))
+{
+	auto p_data = std::make_shared<Data>();
+	pen_type x = 0;
+
+	for(uint32_t code : string)
+	{
+		const auto index = mp_font->glyph_index(code);
+		p_data->glyphs.push_back(index);
+		p_data->pen_x.push_back(x);
+
+		if(index != font_type::NO_GLYPH)
+		{
+			Rectangle<pen_type> grect = mp_font->glyph_rects()[index];
+			grect.move_relative(x,0);
+			p_data->rect.add(grect);
+			x += mp_font->glyph_advances()[index];
+		}
+		else
+			x += mp_font->missing_adv_x();
+	}
+
+	p_data->pen_x.push_back(x);
+	mp_data = std::move(p_data);
+}
+
+//-----------------------------------------------------------------------------
+//	hit_test
+//-----------------------------------------------------------------------------
+//	Returns the index of the character whose advance contains the position x,
+//	relative to the start of the run. Positions before the run return 0 and
+//	positions after it return size().
+//-----------------------------------------------------------------------------
+template<typename T>
+size_t
+BasicTextRun<T>::hit_test(pen_type x) const noexcept
+{
+	if(empty())
+		return 0;
+
+	const auto & pen = mp_data->pen_x;
+	const auto iter = std::upper_bound(begin(pen),end(pen),x);
+	return iter == begin(pen) ? 0 : static_cast<size_t>(iter - begin(pen)) - 1;
+}
+
+template<typename T>
+template<PrimitiveCallback<T> F>
+void
+BasicTextRun<T>::execute(F && callback) const
+{
+	for(const auto index : glyphs())
+		mp_font->execute_glyph(index,callback);
+}
+
+template<typename T>
+template<FontVisitor<T> V>
+void
+BasicTextRun<T>::visit(V & visitor) const
+{
+	for(const auto index : glyphs())
+		mp_font->visit_glyph(index,visitor);
+}
+
+} // namespace vectorfont
+
+#endif // ! defined GUARD_ADE_VECTORFONT_RUN_H
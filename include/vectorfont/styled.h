@@ -0,0 +1,180 @@
+//=============================================================================
+//	FILE:					styled.h
+//	SYSTEM:
+//	DESCRIPTION:	Layout of text made of runs in several fonts.
+//-----------------------------------------------------------------------------
+//  COPYRIGHT:		(C)Copyright 2026 Adrian Purser. All Rights Reserved.
+//	LICENCE:
+//	MAINTAINER:		AJP - Adrian Purser <ade&arcadestuff.com>
+//	CREATED:			16-OCT-2026 Adrian Purser <ade&arcadestuff.com>
+//-----------------------------------------------------------------------------
+//	Rich text, e.g. a bold word inside body text, is a sequence of styled
+//	runs, each with its own font and scale. The runs are laid out one after
+//	the other on a shared baseline, carrying the pen from run to run, into a
+//	single set of segment buffers.
+//
+//	The layout is in line units with the baseline at y = 0 and y pointing up,
+//	like font units. A run's scale converts its font units to line units, so
+//	fonts with different units per em can be mixed by giving each run a scale
+//	of size / units_per_em. The line's ascent and descent are the largest of
+//	the runs' scaled font metrics and can be used to place the line, e.g.
+//	with Affine::translation(x,top + ascent) * Affine::scaling(1,-1).
+//=============================================================================
+#ifndef GUARD_ADE_VECTORFONT_STYLED_H
+#define GUARD_ADE_VECTORFONT_STYLED_H
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <algorithm>
+#include "vectorfont.h"
+#include "layout.h"
+#include "transform.h"
+
+namespace vectorfont
+{
+
+//-----------------------------------------------------------------------------
+//	A run of text in one font. The font must stay valid until the layout has
+//	finished. Runs without a font are skipped.
+//-----------------------------------------------------------------------------
+template<typename T, typename S = std::string_view>
+struct BasicStyledRun
+{
+	const BasicFont<T> *	p_font;
+	float									scale;
+	S											text;
+};
+
+using StyledRun = BasicStyledRun<int16_t>;
+
+struct StyledLayout
+{
+	LayoutSize	size;								// Codes and segments of all of the runs
+	size_t			styled_runs	= 0;		// Number of runs that were completely laid out
+	float				width				= 0.0f;	// Pen position after the last run that was laid out
+	float				ascent			= 0.0f;
+	float				descent			= 0.0f;
+};
+
+namespace detail
+{
+
+template<typename R>
+void
+styled_metrics(const R & runs, StyledLayout & layout) noexcept
+{
+	for(const auto & run : runs)
+		if(run.p_font)
+		{
+			layout.ascent 	= std::max(layout.ascent,static_cast<float>(run.p_font->ascent()) * run.scale);
+			layout.descent 	= std::min(layout.descent,static_cast<float>(run.p_font->descent()) * run.scale);
+		}
+}
+
+} // namespace detail
+
+//-----------------------------------------------------------------------------
+//	styled_size
+//-----------------------------------------------------------------------------
+//	Returns the number of codes and segments of the runs, their width and the
+//	line's ascent and descent, without laying them out.
+//-----------------------------------------------------------------------------
+template<typename R>
+StyledLayout
+styled_size(const R & runs)
+{
+	StyledLayout layout;
+	detail::styled_metrics(runs,layout);
+
+	for(const auto & run : runs)
+	{
+		if(run.p_font)
+		{
+			const auto & font = *run.p_font;
+			typename std::remove_cvref_t<decltype(font)>::pen_type pen_x = 0;
+			for(uint32_t code : run.text)
+			{
+				const auto index = font.glyph_index(code);
+				if(index != std::remove_cvref_t<decltype(font)>::NO_GLYPH)
+				{
+					layout.size.segments += detail::glyph_layout_size(font,index).segments;
+					pen_x += font.glyph_advances()[index];
+				}
+				else
+					pen_x += font.missing_adv_x();
+				++layout.size.codes;
+			}
+			layout.width += static_cast<float>(pen_x) * run.scale;
+		}
+		++layout.styled_runs;
+	}
+
+	return layout;
+}
+
+//-----------------------------------------------------------------------------
+//	layout_styled_segments
+//-----------------------------------------------------------------------------
+//	Lays out the runs as line segments, transformed by the affine transform.
+//	If the buffers are too small then only the glyphs that fit completely
+//	are written. The returned width is in line units.
+//-----------------------------------------------------------------------------
+template<typename R>
+StyledLayout
+layout_styled_segments(const R & runs, const SegmentBuffers<float> & buffers, const Affine & affine = {})
+{
+	StyledLayout layout;
+	detail::styled_metrics(runs,layout);
+	const auto capacity = buffers.capacity();
+
+	for(const auto & run : runs)
+	{
+		if(!run.p_font)
+		{
+			++layout.styled_runs;
+			continue;
+		}
+
+		using font_type = std::remove_cvref_t<decltype(*run.p_font)>;
+		const auto & font = *run.p_font;
+		const auto first 	= layout.size.segments;
+		typename font_type::pen_type pen_x = 0;
+		bool b_full = false;
+
+		for(uint32_t code : run.text)
+		{
+			const auto index = font.glyph_index(code);
+			if(index != font_type::NO_GLYPH)
+			{
+				if(!detail::glyph_segments_fit(font,index,layout.size.segments,capacity))
+				{
+					b_full = true;
+					break;
+				}
+				layout.size.segments = detail::layout_glyph_segments(font,index,static_cast<float>(pen_x),0.0f,buffers,layout.size.segments);
+				pen_x += font.glyph_advances()[index];
+			}
+			else
+				pen_x += font.missing_adv_x();
+			++layout.size.codes;
+		}
+
+		const auto run_affine = affine * Affine::translation(layout.width,0.0f) * Affine::scaling(run.scale,run.scale);
+		const auto count 			= layout.size.segments - first;
+		transform_points(run_affine,buffers.x0.subspan(first,count),buffers.y0.subspan(first,count));
+		transform_points(run_affine,buffers.x1.subspan(first,count),buffers.y1.subspan(first,count));
+		layout.width += static_cast<float>(pen_x) * run.scale;
+
+		if(b_full)
+			break;
+		++layout.styled_runs;
+	}
+
+	return layout;
+}
+
+} // namespace vectorfont
+
+#endif // ! defined GUARD_ADE_VECTORFONT_STYLED_H
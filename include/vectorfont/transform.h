@@ -0,0 +1,358 @@
+//=============================================================================
+//	FILE:					transform.h
+//	SYSTEM:
+//	DESCRIPTION:	Affine transformation of font coordinates.
+//-----------------------------------------------------------------------------
+//  COPYRIGHT:		(C)Copyright 2026 Adrian Purser. All Rights Reserved.
+//	LICENCE:
+//	MAINTAINER:		AJP - Adrian Purser <ade&arcadestuff.com>
+//	CREATED:			16-OCT-2026 Adrian Purser <ade&arcadestuff.com>
+//-----------------------------------------------------------------------------
+//	Maps font coordinates through a 2x3 affine transform so that callers get
+//	device coordinates directly instead of scaling, flipping and translating
+//	each vertex themselves. The parameters of a glyph are transformed as a
+//	block using SSE2, or AVX2 when the compiler targets it, with a scalar
+//	fallback for other targets or when VECTORFONT_NO_SIMD is defined.
+//=============================================================================
+#ifndef GUARD_ADE_VECTORFONT_TRANSFORM_H
+#define GUARD_ADE_VECTORFONT_TRANSFORM_H
+
+#include <cstdint>
+#include <cmath>
+#include <span>
+#include <array>
+#include <type_traits>
+#include <algorithm>
+#include "vectorfont.h"
+#include "layout.h"
+
+#if !defined(VECTORFONT_NO_SIMD)
+	#if defined(__AVX2__)
+		#include <immintrin.h>
+		#define VECTORFONT_AVX2
+	#endif
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+		#include <emmintrin.h>
+		#define VECTORFONT_SSE2
+	#endif
+#endif
+
+namespace vectorfont
+{
+
+//-----------------------------------------------------------------------------
+//	Affine
+//-----------------------------------------------------------------------------
+//		x' = a * x + c * y + tx
+//		y' = b * x + d * y + ty
+//
+//	Transforms are combined with operator*, the right hand transform is
+//	applied first.
+//-----------------------------------------------------------------------------
+struct Affine
+{
+	float		a		= 1.0f;
+	float		b		= 0.0f;
+	float		c		= 0.0f;
+	float		d		= 1.0f;
+	float		tx	= 0.0f;
+	float		ty	= 0.0f;
+
+	static constexpr Affine		identity() noexcept														{return {};}
+	static constexpr Affine		translation(float x, float y) noexcept				{return {1.0f,0.0f,0.0f,1.0f,x,y};}
+	static constexpr Affine		scaling(float sx, float sy) noexcept					{return {sx,0.0f,0.0f,sy,0.0f,0.0f};}
+	static constexpr Affine		shear(float shx, float shy = 0.0f) noexcept		{return {1.0f,shy,shx,1.0f,0.0f,0.0f};}
+	static inline Affine			rotation(float radians) noexcept							{const float s = std::sin(radians), co = std::cos(radians); return {co,s,-s,co,0.0f,0.0f};}
+
+	// Scales font units to a size in pixels and flips y so that it points
+	// down, with the baseline at (x,y).
+	static constexpr Affine		font_scale(float size, int units_per_em, float x = 0.0f, float y = 0.0f) noexcept
+	{
+		const float scale = units_per_em ? size / static_cast<float>(units_per_em) : 0.0f;
+		return {scale,0.0f,0.0f,-scale,x,y};
+	}
+
+	constexpr Affine operator*(const Affine & rhs) const noexcept
+	{
+		return {	a * rhs.a + c * rhs.b,
+							b * rhs.a + d * rhs.b,
+							a * rhs.c + c * rhs.d,
+							b * rhs.c + d * rhs.d,
+							a * rhs.tx + c * rhs.ty + tx,
+							b * rhs.tx + d * rhs.ty + ty };
+	}
+
+	constexpr float	map_x(float x, float y) const noexcept	{return a * x + c * y + tx;}
+	constexpr float	map_y(float x, float y) const noexcept	{return b * x + d * y + ty;}
+};
+
+namespace detail
+{
+
+template<typename O>
+inline O
+to_output(float value) noexcept
+{
+	if constexpr (std::is_floating_point_v<O>)
+		return static_cast<O>(value);
+	else
+		return static_cast<O>(std::lrint(value));
+}
+
+#if defined(VECTORFONT_SSE2)
+template<typename O>
+inline void
+store_points(O * p_out, __m128 value) noexcept
+{
+	if constexpr (std::is_same_v<O,float>)
+		_mm_storeu_ps(p_out,value);
+	else
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(p_out),_mm_cvtps_epi32(value));
+}
+#endif
+
+#if defined(VECTORFONT_AVX2)
+template<typename O>
+inline void
+store_points(O * p_out, __m256 value) noexcept
+{
+	if constexpr (std::is_same_v<O,float>)
+		_mm256_storeu_ps(p_out,value);
+	else
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(p_out),_mm256_cvtps_epi32(value));
+}
+#endif
+
+} // namespace detail
+
+//-----------------------------------------------------------------------------
+//	transform_points
+//-----------------------------------------------------------------------------
+//	Transforms interleaved x,y coordinates, such as the parameters of a glyph,
+//	into the output. The output must be at least as large as the input.
+//	Integer outputs are rounded to the nearest value. The SIMD paths are used
+//	for float and int16_t coordinates output as float or int32_t.
+//-----------------------------------------------------------------------------
+template<typename T, typename O>
+void
+transform_points(const Affine & affine, std::span<const T> points, std::span<O> output) noexcept
+{
+	const size_t count = points.size() & ~size_t{1};
+	size_t i = 0;
+
+	[[maybe_unused]] constexpr bool b_simd = (std::is_same_v<T,float> || std::is_same_v<T,int16_t>) && (std::is_same_v<O,float> || std::is_same_v<O,int32_t>);
+
+#if defined(VECTORFONT_AVX2)
+	if constexpr (b_simd)
+	{
+		const __m256 xcoef 	= _mm256_setr_ps(affine.a,affine.b,affine.a,affine.b,affine.a,affine.b,affine.a,affine.b);
+		const __m256 ycoef 	= _mm256_setr_ps(affine.c,affine.d,affine.c,affine.d,affine.c,affine.d,affine.c,affine.d);
+		const __m256 offset	= _mm256_setr_ps(affine.tx,affine.ty,affine.tx,affine.ty,affine.tx,affine.ty,affine.tx,affine.ty);
+
+		for(; (i + 8) <= count; i += 8)
+		{
+			__m256 xy;
+			if constexpr (std::is_same_v<T,float>)
+				xy = _mm256_loadu_ps(points.data() + i);
+			else
+				xy = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(points.data() + i))));
+
+			const __m256 xx = _mm256_moveldup_ps(xy);
+			const __m256 yy = _mm256_movehdup_ps(xy);
+			detail::store_points(output.data() + i,_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(xx,xcoef),_mm256_mul_ps(yy,ycoef)),offset));
+		}
+	}
+#endif
+
+#if defined(VECTORFONT_SSE2)
+	if constexpr (b_simd)
+	{
+		const __m128 xcoef 	= _mm_setr_ps(affine.a,affine.b,affine.a,affine.b);
+		const __m128 ycoef 	= _mm_setr_ps(affine.c,affine.d,affine.c,affine.d);
+		const __m128 offset	= _mm_setr_ps(affine.tx,affine.ty,affine.tx,affine.ty);
+
+		for(; (i + 4) <= count; i += 4)
+		{
+			__m128 xy;
+			if constexpr (std::is_same_v<T,float>)
+				xy = _mm_loadu_ps(points.data() + i);
+			else
+			{
+				const __m128i v16 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(points.data() + i));
+				xy = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v16,v16),16));
+			}
+
+			const __m128 xx = _mm_shuffle_ps(xy,xy,_MM_SHUFFLE(2,2,0,0));
+			const __m128 yy = _mm_shuffle_ps(xy,xy,_MM_SHUFFLE(3,3,1,1));
+			detail::store_points(output.data() + i,_mm_add_ps(_mm_add_ps(_mm_mul_ps(xx,xcoef),_mm_mul_ps(yy,ycoef)),offset));
+		}
+	}
+#endif
+
+	for(; i < count; i += 2)
+	{
+		const auto x = static_cast<float>(points[i]);
+		const auto y = static_cast<float>(points[i + 1]);
+		output[i]			= detail::to_output<O>(affine.map_x(x,y));
+		output[i + 1] = detail::to_output<O>(affine.map_y(x,y));
+	}
+}
+
+//-----------------------------------------------------------------------------
+//	Transforms separate x and y arrays in place, e.g. the buffers filled by
+//	layout_segments() or layout_polylines().
+//-----------------------------------------------------------------------------
+inline void
+transform_points(const Affine & affine, std::span<float> x, std::span<float> y) noexcept
+{
+	const size_t count = std::min(x.size(),y.size());
+	size_t i = 0;
+
+#if defined(VECTORFONT_AVX2)
+	{
+		const __m256 a = _mm256_set1_ps(affine.a), b = _mm256_set1_ps(affine.b), c = _mm256_set1_ps(affine.c), d = _mm256_set1_ps(affine.d);
+		const __m256 tx = _mm256_set1_ps(affine.tx), ty = _mm256_set1_ps(affine.ty);
+		for(; (i + 8) <= count; i += 8)
+		{
+			const __m256 vx = _mm256_loadu_ps(x.data() + i);
+			const __m256 vy = _mm256_loadu_ps(y.data() + i);
+			_mm256_storeu_ps(x.data() + i,_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vx,a),_mm256_mul_ps(vy,c)),tx));
+			_mm256_storeu_ps(y.data() + i,_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vx,b),_mm256_mul_ps(vy,d)),ty));
+		}
+	}
+#endif
+
+#if defined(VECTORFONT_SSE2)
+	{
+		const __m128 a = _mm_set1_ps(affine.a), b = _mm_set1_ps(affine.b), c = _mm_set1_ps(affine.c), d = _mm_set1_ps(affine.d);
+		const __m128 tx = _mm_set1_ps(affine.tx), ty = _mm_set1_ps(affine.ty);
+		for(; (i + 4) <= count; i += 4)
+		{
+			const __m128 vx = _mm_loadu_ps(x.data() + i);
+			const __m128 vy = _mm_loadu_ps(y.data() + i);
+			_mm_storeu_ps(x.data() + i,_mm_add_ps(_mm_add_ps(_mm_mul_ps(vx,a),_mm_mul_ps(vy,c)),tx));
+			_mm_storeu_ps(y.data() + i,_mm_add_ps(_mm_add_ps(_mm_mul_ps(vx,b),_mm_mul_ps(vy,d)),ty));
+		}
+	}
+#endif
+
+	for(; i < count; ++i)
+	{
+		const float vx = x[i];
+		const float vy = y[i];
+		x[i] = affine.map_x(vx,vy);
+		y[i] = affine.map_y(vx,vy);
+	}
+}
+
+namespace detail
+{
+
+//-----------------------------------------------------------------------------
+//	Executes a single glyph, transforming its parameters in blocks of up to
+//	TRANSFORM_BLOCK. Only the glyph's own parameters are transformed. Doesn't 
+//	execute the PEN_POSITION.
+//-----------------------------------------------------------------------------
+inline constexpr size_t TRANSFORM_BLOCK = 64;
+
+template<typename O, typename T, typename F>
+void
+execute_transformed_glyph(const BasicFont<T> & font, index_type index, const Affine & glyph_affine, std::array<O,TRANSFORM_BLOCK> & buffer, F && callback)
+{
+	const auto		params 			= font.parameters();
+	const auto & 	range 			= font.glyph_ranges()[index];
+	const auto		primitives	= font.primitives().subspan(range.primitive_index,range.primitive_count);
+	size_t 				block_begin = 0;
+	size_t 				block_end 	= 0;
+	size_t 				param_index = range.parameter_index;
+	size_t				glyph_end		= param_index;
+
+	for(const auto primitive : primitives)
+		glyph_end += parameter_count(primitive);
+
+	for(const auto primitive : primitives)
+	{
+		const size_t pcount = parameter_count(primitive);
+		if((param_index + pcount) > block_end)
+		{
+			block_begin = param_index;
+			block_end		= std::min(glyph_end,param_index + TRANSFORM_BLOCK);
+			transform_points(glyph_affine,params.subspan(block_begin,block_end - block_begin),std::span<O>(buffer));
+		}
+
+		const bool b_stop = callback(primitive,std::span<const O>(buffer.data() + (param_index - block_begin),pcount));
+		param_index += pcount;
+		if(b_stop)
+			break;
+	}
+}
+
+template<typename O, typename F>
+void
+execute_transformed_advance(const Affine & affine, float pen_x, F && callback)
+{
+	const std::array<O,2> pen{to_output<O>(affine.map_x(pen_x,0.0f)),to_output<O>(affine.map_y(pen_x,0.0f))};
+	callback(vectorfont::Primitive{vectorfont::command::PEN_POSITION},std::span<const O>(pen));
+}
+
+} // namespace detail
+
+//-----------------------------------------------------------------------------
+//	execute_transformed
+//-----------------------------------------------------------------------------
+//	As BasicFont::execute() but the parameters passed to the callback have
+//	been transformed to output coordinates of type O. The pen position is
+//	tracked internally so, instead of ADVANCE, each character ends with a
+//	PEN_POSITION command that is passed the transformed position of the pen
+//	after advancing, as x,y.
+//-----------------------------------------------------------------------------
+template<typename O = float, typename T, typename S, typename F>
+	requires PrimitiveCallback<F,O>
+void
+execute_transformed(const BasicFont<T> & font, const S & string, const Affine & affine, F && callback)
+{
+	std::array<O,detail::TRANSFORM_BLOCK>	buffer;
+	typename BasicFont<T>::pen_type				pen_x = 0;
+
+	for(uint32_t code : string)
+	{
+		const auto index = font.glyph_index(code);
+		if(index != BasicFont<T>::NO_GLYPH)
+		{
+			detail::execute_transformed_glyph(font,index,affine * Affine::translation(static_cast<float>(pen_x),0.0f),buffer,callback);
+			pen_x += font.glyph_advances()[index];
+		}
+		else
+			pen_x += font.missing_adv_x();
+
+		detail::execute_transformed_advance<O>(affine,static_cast<float>(pen_x),callback);
+	}
+}
+
+//-----------------------------------------------------------------------------
+//	layout_segments / layout_polylines
+//-----------------------------------------------------------------------------
+//	Lay out the string and then transform the output buffers in place.
+//-----------------------------------------------------------------------------
+template<typename T, typename S>
+LayoutSize
+layout_segments(const BasicFont<T> & font, const S & string, const SegmentBuffers<float> & buffers, const Affine & affine)
+{
+	const auto size = layout_segments(font,string,buffers);
+	transform_points(affine,buffers.x0.first(size.segments),buffers.y0.first(size.segments));
+	transform_points(affine,buffers.x1.first(size.segments),buffers.y1.first(size.segments));
+	return size;
+}
+
+template<typename T, typename S>
+LayoutSize
+layout_polylines(const BasicFont<T> & font, const S & string, const PolylineBuffers<float> & buffers, const Affine & affine)
+{
+	const auto size = layout_polylines(font,string,buffers);
+	transform_points(affine,buffers.x.first(size.vertices),buffers.y.first(size.vertices));
+	return size;
+}
+
+} // namespace vectorfont
+
+#endif // ! defined GUARD_ADE_VECTORFONT_TRANSFORM_H
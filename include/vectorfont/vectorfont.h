@@ -19,6 +19,12 @@
 #include <algorithm>
 #include <functional>
 #include <span>
+#include <unordered_map>
+#include <memory>
+#include <memory_resource>
+#include <limits>
+#include <type_traits>
+#include <concepts>
 #include "rectangle.h"
 
 namespace vectorfont
@@ -26,6 +32,15 @@ namespace vectorfont
 
 using Rect = vectorfont::Rectangle<int16_t>;
 
+// Type used to index glyphs, primitives and parameters. Defining 
+// VECTORFONT_COMPACT_INDEX halves the size of the indices but limits a font
+// to 65535 parameters.
+#if defined(VECTORFONT_COMPACT_INDEX)
+using index_type = uint16_t;
+#else
+using index_type = uint32_t;
+#endif
+
 namespace command
 {
 enum 
@@ -34,6 +49,9 @@ enum
 		MOVETO,				//	x, y
 		LINETO,				//	x, y
 		ADVANCE,			//	delta_x
+		PEN_POSITION,	//	x, y		The absolute pen position in output coordinates, passed
+									//				instead of ADVANCE by the transformed execution functions.
+									//				Never stored in a font.
 };
 } // namespace command
 
@@ -52,157 +70,603 @@ struct Primitive
 	unsigned char cap:2 = 0;
 };
 
-struct Glyph
+// Returns the number of parameters that a primitive reads from the parameter array.
+constexpr size_t parameter_count(vectorfont::Primitive primitive) noexcept
+{
+	switch(primitive.command)
+	{
+		case vectorfont::command::MOVETO : return 2;
+		case vectorfont::command::LINETO : return 2;
+		default : return 0;
+	}
+}
+
+//-----------------------------------------------------------------------------
+//	Glyph
+//-----------------------------------------------------------------------------
+//	A view of a single glyph. The font stores the glyph fields in separate 
+//	arrays, this is assembled from them by Font::glyph() and Font::get_glyph().
+//-----------------------------------------------------------------------------
+template<typename T>
+struct BasicGlyph
 {
-	uint32_t					code;
-	vectorfont::Rect	rect;
-	uint16_t					parameter_index;
-	uint16_t					primitive_index;
-	uint16_t					primitive_count;
-	int16_t						advance_x;
+	uint32_t								code;
+	vectorfont::Rectangle<T>	rect;
+	index_type							parameter_index;
+	index_type							primitive_index;
+	index_type							primitive_count;
+	T												advance_x;
 };
 
-struct Font
+using Glyph = BasicGlyph<int16_t>;
+
+struct GlyphRange
 {
-	std::vector<int16_t>								parameters;
-	std::vector<vectorfont::Primitive>	primitives;
-	std::vector<vectorfont::Glyph>			glyphs;
-	Rect																rect;
-	
-	std::string													id;
+	index_type				parameter_index;
+	index_type				primitive_index;
+	index_type				primitive_count;
+};
 
-	int16_t															ascent 				= 0;
-	int16_t															descent				= 0;
-	int16_t															units_per_em 	= 0;
-	int16_t															missing_adv_x	= 0;
+// The polyline strips of a glyph, see BasicFont::strip().
+struct GlyphStrips
+{
+	index_type				strip_index;
+	index_type				strip_count;
+};
 
-	int16_t																			width() const noexcept 			{return rect.width();}
-	int16_t																			height() const noexcept 		{return rect.height();}
-	inline const vectorfont::Glyph *				 		get_glyph(uint32_t code) const;
-	inline void 																update_size(int16_t x,int16_t y) noexcept;
-	inline void																	start_glyph(uint32_t code, int16_t advance_x);
-	inline void																	moveto(int16_t x, int16_t y);	
-	inline void																	lineto(int16_t x, int16_t y, int linecap = vectorfont::cap::ROUND);
+// The geometry of a font at one level of detail. The glyph ranges are
+// indexed by glyph index and refer to the parameters and primitives.
+template<typename T>
+struct GlyphGeometry
+{
+	std::span<const T>											parameters;
+	std::span<const vectorfont::Primitive>	primitives;
+	std::span<const vectorfont::GlyphRange>	glyph_ranges;
+};
 
-	template<typename T>	void									execute(const T& string, std::function<bool(vectorfont::Primitive,std::span<const int16_t>)> callback) const;
-	inline void																	execute(uint32_t code, std::function<bool(vectorfont::Primitive,std::span<const int16_t>)> callback) const;
+//-----------------------------------------------------------------------------
+//	MemoryUsage
+//-----------------------------------------------------------------------------
+//	The number of bytes allocated by a font, broken down by what they store.
+//	Sizes are taken from the capacity of the containers so they include any 
+//	unused growth space.
+//-----------------------------------------------------------------------------
+struct MemoryUsage
+{
+	size_t		glyphs			= 0;		// Glyph codes, advances, ranges and rects
+	size_t		primitives	= 0;
+	size_t		parameters	= 0;
+	size_t		index				= 0;		// Code to glyph index tables
+	size_t		strips			= 0;		// Polyline strips
+	size_t		other				= 0;		// The font object itself and its id
+
+	size_t		total() const noexcept	{return glyphs + primitives + parameters + index + strips + other;}
+};
+
+namespace detail
+{
+template<typename C>
+constexpr size_t allocated_bytes(const C & container) noexcept {return container.capacity() * sizeof(typename C::value_type);}
+} // namespace detail
+
+//-----------------------------------------------------------------------------
+//	GlyphHistogram
+//-----------------------------------------------------------------------------
+//	Counts how often each code is rendered. This can be recorded from a sample
+//	corpus or at runtime through Font::execute() and then passed to 
+//	FontBuilder::reorder() to pack the most used glyphs together.
+//-----------------------------------------------------------------------------
+struct GlyphHistogram
+{
+	std::unordered_map<uint32_t,uint64_t>	counts;
+
+	void	record(uint32_t code, uint64_t count = 1)	{counts[code] += count;}
+	void	clear() noexcept 													{counts.clear();}
 
-	template<typename T>	vectorfont::Rect			string_rect(const T& string) const;
+	template<typename T>
+	void	record_string(const T & string)
+	{
+		for(uint32_t code : string)
+			record(code);
+	}
+
+	uint64_t count(uint32_t code) const
+	{
+		auto ifind = counts.find(code);
+		return ifind == end(counts) ? 0 : ifind->second;
+	}
 };
 
-inline const vectorfont::Glyph * 	
-Font::get_glyph(uint32_t code) const
+//-----------------------------------------------------------------------------
+//	GlyphIndex
+//-----------------------------------------------------------------------------
+//	Maps codes to glyph indices. If the codes densely cover their range then a
+//	single direct lookup table is built for the whole range, otherwise the 
+//	table only covers the first LOOKUP_SIZE codes and the remaining codes are
+//	placed in a sorted table that is binary searched. If a code is defined 
+//	more than once then the first definition wins.
+//-----------------------------------------------------------------------------
+struct GlyphIndex
+{
+	static constexpr uint32_t						LOOKUP_SIZE		= 256;		// Minimum codes covered by the direct lookup table (ASCII/Latin-1)
+	static constexpr uint32_t						LOOKUP_DENSITY	= 4;		// Use a single direct table when at least 1 in N codes in the range is defined
+	static constexpr index_type					NO_GLYPH			= std::numeric_limits<index_type>::max();
+
+	using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+	std::pmr::vector<index_type>				lookup;								// code - lookup_base -> glyph index
+	std::pmr::vector<uint32_t>					sparse_codes;					// Sorted codes outside of the lookup table
+	std::pmr::vector<index_type>				sparse_glyphs;				// Glyph index for each of sparse_codes
+	uint32_t														lookup_base = 0;
+
+	GlyphIndex() = default;
+	GlyphIndex(const GlyphIndex &) = default;
+	GlyphIndex(GlyphIndex &&) = default;
+	explicit GlyphIndex(const allocator_type & alloc) : lookup(alloc), sparse_codes(alloc), sparse_glyphs(alloc) {}
+	GlyphIndex(const GlyphIndex & other, const allocator_type & alloc) 
+		: lookup(other.lookup,alloc), sparse_codes(other.sparse_codes,alloc), sparse_glyphs(other.sparse_glyphs,alloc), lookup_base(other.lookup_base) {}
+	GlyphIndex & operator=(const GlyphIndex &) = default;
+	GlyphIndex & operator=(GlyphIndex &&) = default;
+
+	allocator_type		get_allocator() const noexcept {return lookup.get_allocator();}
+
+	bool		empty() const noexcept {return lookup.empty();}
+	inline void				clear() noexcept;
+	inline void				build(std::span<const uint32_t> codes);
+	inline index_type	find(uint32_t code) const noexcept;
+
+	size_t	memory_usage() const noexcept {return detail::allocated_bytes(lookup) + detail::allocated_bytes(sparse_codes) + detail::allocated_bytes(sparse_glyphs);}
+};
+
+inline void
+GlyphIndex::clear() noexcept
 {
-	auto ifind = std::find_if(begin(glyphs),end(glyphs),[code](const vectorfont::Glyph & glyph)->bool{return glyph.code == code;});
-	if(ifind == end(glyphs))
-		return nullptr;
-	return &(*ifind); 
+	lookup.clear();
+	sparse_codes.clear();
+	sparse_glyphs.clear();
+	lookup_base = 0;
 }
 
-void Font::start_glyph(uint32_t code, int16_t advance_x )
+inline void
+GlyphIndex::build(std::span<const uint32_t> glyph_codes)
 {
-	vectorfont::Glyph glyph;
-	glyph.code 						= code;
-	glyph.advance_x				= advance_x;
-	glyph.parameter_index = parameters.size();
-	glyph.primitive_index = primitives.size();
-	glyph.primitive_count	= 0;
-	glyphs.push_back(glyph);
+	clear();
+
+	std::pmr::vector<std::pair<uint32_t,index_type>> codes(get_allocator());
+	codes.reserve(glyph_codes.size());
+	for(size_t index = 0; index < std::min(glyph_codes.size(),size_t{NO_GLYPH}); ++index)
+		codes.emplace_back(glyph_codes[index],static_cast<index_type>(index));
+
+	// Sorting by code and then index keeps the first glyph of a code without
+	// the temporary buffer of a stable sort, which would come from the heap.
+	std::sort(begin(codes),end(codes));
+	codes.erase(std::unique(begin(codes),end(codes),[](const auto & a, const auto & b){return a.first == b.first;}),end(codes));
+
+	uint32_t lookup_end = LOOKUP_SIZE;
+	if(!codes.empty())
+	{
+		const uint64_t span = uint64_t{codes.back().first} - codes.front().first + 1;
+		if((codes.back().first >= LOOKUP_SIZE) && ((span / LOOKUP_DENSITY) <= codes.size()))
+		{
+			lookup_base = codes.front().first;
+			lookup_end	= codes.back().first + 1;
+		}
+	}
+
+	lookup.assign(lookup_end - lookup_base,NO_GLYPH);
+
+	for(const auto & [code,index] : codes)
+	{
+		if((code - lookup_base) < lookup.size())
+			lookup[code - lookup_base] = index;
+		else
+		{
+			sparse_codes.push_back(code);
+			sparse_glyphs.push_back(index);
+		}
+	}
+
+	sparse_codes.shrink_to_fit();
+	sparse_glyphs.shrink_to_fit();
 }
 
-void Font::moveto(int16_t x, int16_t y)
+inline index_type
+GlyphIndex::find(uint32_t code) const noexcept
 {
-	if(!glyphs.empty())
+	if((code - lookup_base) < lookup.size())
+		return lookup[code - lookup_base];
+
+	// Branchless binary search for the last code that is <= the requested code.
+	size_t count = sparse_codes.size();
+	if(count == 0)
+		return NO_GLYPH;
+
+	const uint32_t * p_base = sparse_codes.data();
+	while(count > 1)
 	{
-		parameters.push_back(x);
-		parameters.push_back(y);
-
-		Primitive primitive;
-		primitive.command = vectorfont::command::MOVETO;
-		primitive.cap			= 0;
-		primitives.push_back(primitive);
-
-		auto & glyph = glyphs.back();
-		glyph.primitive_count++;
-		glyph.rect.add(x,y);
-		rect.add(x,y);
+		const size_t half = count / 2;
+		p_base += (p_base[half] <= code) ? half : 0;
+		count -= half;
 	}
+
+	return (*p_base == code) ? sparse_glyphs[p_base - sparse_codes.data()] : NO_GLYPH;
 }
 
-void Font::lineto(int16_t x, int16_t y, int linecap)
+//-----------------------------------------------------------------------------
+//	BasicFont
+//-----------------------------------------------------------------------------
+//	The font is templated on the type used to store coordinates. Use int8_t
+//	to minimise the memory used by fonts with small coordinates or float to
+//	avoid converting coordinates in floating point pipelines. Font is the 
+//	int16_t variant that matches the precision of the SVG fonts.
+//
+//	Fonts are created by the loaders or a BasicFontBuilder and are immutable
+//	once built. None of the member functions modify the font or any shared
+//	state, so a font may be shared between any number of threads, e.g. as a
+//	std::shared_ptr<const Font>, and rendered from concurrently without 
+//	locking.
+//-----------------------------------------------------------------------------
+template<typename T> class BasicFontBuilder;
+
+//-----------------------------------------------------------------------------
+//	Primitive callbacks and visitors
+//-----------------------------------------------------------------------------
+//	execute() accepts any callable that takes a primitive and its parameters
+//	and returns true to stop executing the current glyph. Passing the callable
+//	as a template parameter, rather than through a std::function, lets the 
+//	compiler inline it into the primitive loop.
+//
+//	Alternatively a visitor with separate moveto, lineto and advance member
+//	functions can be passed to visit(). The member functions are resolved at
+//	compile time so there is no switch on the command in the visitor.
+//-----------------------------------------------------------------------------
+template<typename F, typename T>
+concept PrimitiveCallback = std::predicate<F &,vectorfont::Primitive,std::span<const T>>;
+
+template<typename V, typename T>
+concept FontVisitor = requires(V & visitor, T value, int linecap)
 {
-	if(!glyphs.empty())
+	visitor.moveto(value,value);
+	visitor.lineto(value,value,linecap);
+	visitor.advance(value);
+};
+
+template<typename T>
+class BasicFont
+{
+public:
+	using coord_type		= T;
+	using rect_type			= vectorfont::Rectangle<T>;
+	using glyph_type		= vectorfont::BasicGlyph<T>;
+	using pen_type			= std::conditional_t<std::is_floating_point_v<T>,T,int32_t>;	// Accumulates advances along a string
+	using callback_type	= std::function<bool(vectorfont::Primitive,std::span<const T>)>;
+	using allocator_type	= std::pmr::polymorphic_allocator<std::byte>;
+
+	static constexpr index_type					NO_GLYPH			= GlyphIndex::NO_GLYPH;
+	static constexpr size_t							MAX_INDEX			= std::numeric_limits<index_type>::max();
+
+private:
+	friend class BasicFontBuilder<T>;
+
+	std::pmr::vector<T>													m_parameters;
+	std::pmr::vector<vectorfont::Primitive>			m_primitives;
+
+	// Glyph records, stored as parallel arrays indexed by glyph index.
+	std::pmr::vector<uint32_t>									m_glyph_codes;
+	std::pmr::vector<T>													m_glyph_advances;
+	std::pmr::vector<vectorfont::GlyphRange>		m_glyph_ranges;
+	std::pmr::vector<rect_type>									m_glyph_rects;
+
+	vectorfont::GlyphIndex											m_code_index;
+	rect_type																		m_rect;
+	
+	std::pmr::string														m_id;
+
+	// Simplified levels of detail, built by BasicFontBuilder. Level 0 is the
+	// full geometry above, the glyph ranges of level n are stored at 
+	// (n - 1) * glyph_count().
+	std::pmr::vector<float>											m_lod_tolerances;
+	std::pmr::vector<T>													m_lod_parameters;
+	std::pmr::vector<vectorfont::Primitive>			m_lod_primitives;
+	std::pmr::vector<vectorfont::GlyphRange>		m_lod_ranges;
+
+	// The strokes of each glyph joined into polylines, built by 
+	// BasicFontBuilder when enabled with set_build_strips(). Empty otherwise.
+	std::pmr::vector<T>													m_strip_vertices;		// x,y of each vertex
+	std::pmr::vector<index_type>								m_strip_offsets;		// First vertex of each strip plus the end
+	std::pmr::vector<vectorfont::GlyphStrips>		m_glyph_strips;
+	int16_t															m_ascent 				= 0;
+	int16_t															m_descent				= 0;
+	int16_t															m_units_per_em 	= 0;
+	T																		m_missing_adv_x	= 0;
+
+public:
+	BasicFont() = default;
+	BasicFont(const BasicFont &) = default;
+	BasicFont(BasicFont &&) = default;
+	inline explicit BasicFont(const allocator_type & alloc);
+	inline BasicFont(const BasicFont & other, const allocator_type & alloc);
+	BasicFont & operator=(const BasicFont &) = default;
+	BasicFont & operator=(BasicFont &&) = default;
+
+	allocator_type															get_allocator() const noexcept	{return m_parameters.get_allocator();}
+
+	std::span<const T>													parameters() const noexcept			{return m_parameters;}
+	std::span<const vectorfont::Primitive>			primitives() const noexcept			{return m_primitives;}
+	std::span<const uint32_t>										glyph_codes() const noexcept		{return m_glyph_codes;}
+	std::span<const T>													glyph_advances() const noexcept	{return m_glyph_advances;}
+	std::span<const vectorfont::GlyphRange>			glyph_ranges() const noexcept		{return m_glyph_ranges;}
+	std::span<const rect_type>									glyph_rects() const noexcept		{return m_glyph_rects;}
+	const vectorfont::GlyphIndex &							code_index() const noexcept			{return m_code_index;}
+	const rect_type &														rect() const noexcept						{return m_rect;}
+	std::string_view														id() const noexcept							{return m_id;}
+	int16_t																			ascent() const noexcept					{return m_ascent;}
+	int16_t																			descent() const noexcept				{return m_descent;}
+	int16_t																			units_per_em() const noexcept		{return m_units_per_em;}
+	const T &																		missing_adv_x() const noexcept	{return m_missing_adv_x;}
+
+	T																						width() const noexcept 			{return m_rect.width();}
+	T																						height() const noexcept 		{return m_rect.height();}
+	size_t																			glyph_count() const noexcept	{return m_glyph_codes.size();}
+	inline glyph_type														glyph(size_t index) const;
+	index_type																	glyph_index(uint32_t code) const noexcept {return m_code_index.find(code);}
+	inline std::optional<glyph_type>						get_glyph(uint32_t code) const;
+	inline MemoryUsage													memory_usage() const noexcept;
+
+	size_t																			lod_count() const noexcept								{return m_lod_tolerances.size() + 1;}
+	float																				lod_tolerance(size_t level) const noexcept	{level = std::min(level,lod_count() - 1); return level ? m_lod_tolerances[level - 1] : 0.0f;}
+	inline GlyphGeometry<T>											geometry(size_t level = 0) const noexcept;
+
+	std::span<const T>													strip_vertices() const noexcept	{return m_strip_vertices;}
+	std::span<const index_type>									strip_offsets() const noexcept	{return m_strip_offsets;}
+	std::span<const vectorfont::GlyphStrips>		glyph_strips() const noexcept		{return m_glyph_strips;}
+	inline std::span<const T>										strip(size_t strip_index) const noexcept;
+	template<typename S, PrimitiveCallback<T> F>	void	execute(const S& string, F && callback) const;
+	template<PrimitiveCallback<T> F>	void						execute(uint32_t code, F && callback) const	{execute_glyph(glyph_index(code),callback);}
+	template<typename S, PrimitiveCallback<T> F>	void	execute(const S& string, F && callback, GlyphHistogram & histogram) const;
+	inline void																	execute(uint32_t code, const callback_type & callback) const	{execute<const callback_type &>(code,callback);}
+
+	template<typename S, FontVisitor<T> V>	void				visit(const S& string, V & visitor) const;
+	template<FontVisitor<T> V>	void									visit(uint32_t code, V & visitor) const	{visit_glyph(glyph_index(code),visitor);}
+
+	// Execute a glyph by its index rather than its code, optionally at a 
+	// level of detail. NO_GLYPH executes the missing glyph advance. Levels
+	// beyond the last level of detail use the last level.
+	template<PrimitiveCallback<T> F>	void						execute_glyph(index_type index, F && callback, size_t level = 0) const;
+	template<FontVisitor<T> V>	void									visit_glyph(index_type index, V & visitor) const;
+
+	template<typename S>	Rectangle<pen_type>		string_rect(const S& string) const;
+};
+
+using Font = BasicFont<int16_t>;
+
+//-----------------------------------------------------------------------------
+//	Fonts made by BasicFontBuilder::build() and the loaders are allocated from
+//	the font's own memory resource, so they are owned by a pointer which 
+//	returns them to it.
+//-----------------------------------------------------------------------------
+template<typename T>
+struct FontDeleter
+{
+	void operator()(BasicFont<T> * p_font) const noexcept
+	{
+		auto alloc = p_font->get_allocator();
+		alloc.delete_object(p_font);
+	}
+};
+
+template<typename T>	using BasicFontPtr = std::unique_ptr<BasicFont<T>,FontDeleter<T>>;
+using FontPtr = BasicFontPtr<int16_t>;
+
+//-----------------------------------------------------------------------------
+//	The font's storage, including its code index, is allocated from the 
+//	memory resource of the allocator. 
+//-----------------------------------------------------------------------------
+template<typename T>
+BasicFont<T>::BasicFont(const allocator_type & alloc)
+	: m_parameters(alloc)
+	, m_primitives(alloc)
+	, m_glyph_codes(alloc)
+	, m_glyph_advances(alloc)
+	, m_glyph_ranges(alloc)
+	, m_glyph_rects(alloc)
+	, m_code_index(alloc)
+	, m_id(alloc)
+	, m_lod_tolerances(alloc)
+	, m_lod_parameters(alloc)
+	, m_lod_primitives(alloc)
+	, m_lod_ranges(alloc)
+	, m_strip_vertices(alloc)
+	, m_strip_offsets(alloc)
+	, m_glyph_strips(alloc)
+{
+}
+
+template<typename T>
+BasicFont<T>::BasicFont(const BasicFont & other, const allocator_type & alloc)
+	: m_parameters(other.m_parameters,alloc)
+	, m_primitives(other.m_primitives,alloc)
+	, m_glyph_codes(other.m_glyph_codes,alloc)
+	, m_glyph_advances(other.m_glyph_advances,alloc)
+	, m_glyph_ranges(other.m_glyph_ranges,alloc)
+	, m_glyph_rects(other.m_glyph_rects,alloc)
+	, m_code_index(other.m_code_index,alloc)
+	, m_rect(other.m_rect)
+	, m_id(other.m_id,alloc)
+	, m_lod_tolerances(other.m_lod_tolerances,alloc)
+	, m_lod_parameters(other.m_lod_parameters,alloc)
+	, m_lod_primitives(other.m_lod_primitives,alloc)
+	, m_lod_ranges(other.m_lod_ranges,alloc)
+	, m_strip_vertices(other.m_strip_vertices,alloc)
+	, m_strip_offsets(other.m_strip_offsets,alloc)
+	, m_glyph_strips(other.m_glyph_strips,alloc)
+	, m_ascent(other.m_ascent)
+	, m_descent(other.m_descent)
+	, m_units_per_em(other.m_units_per_em)
+	, m_missing_adv_x(other.m_missing_adv_x)
+{
+}
+
+template<typename T>
+inline MemoryUsage
+BasicFont<T>::memory_usage() const noexcept
+{
+	MemoryUsage usage;
+	usage.glyphs 			= detail::allocated_bytes(m_glyph_codes) + detail::allocated_bytes(m_glyph_advances) + detail::allocated_bytes(m_glyph_ranges) + detail::allocated_bytes(m_glyph_rects) + detail::allocated_bytes(m_lod_ranges);
+	usage.primitives	= detail::allocated_bytes(m_primitives) + detail::allocated_bytes(m_lod_primitives);
+	usage.parameters	= detail::allocated_bytes(m_parameters) + detail::allocated_bytes(m_lod_parameters);
+	usage.index				= m_code_index.memory_usage();
+	usage.strips			= detail::allocated_bytes(m_strip_vertices) + detail::allocated_bytes(m_strip_offsets) + detail::allocated_bytes(m_glyph_strips);
+	usage.other				= sizeof(*this) + m_id.capacity() + detail::allocated_bytes(m_lod_tolerances);
+	return usage;
+}
+
+//-----------------------------------------------------------------------------
+//	Returns the geometry of a level of detail. Levels beyond the last level
+//	return the last level.
+//-----------------------------------------------------------------------------
+template<typename T>
+inline GlyphGeometry<T>
+BasicFont<T>::geometry(size_t level) const noexcept
+{
+	level = std::min(level,lod_count() - 1);
+	if(level == 0)
+		return {m_parameters,m_primitives,m_glyph_ranges};
+	return {m_lod_parameters,m_lod_primitives,std::span<const vectorfont::GlyphRange>(m_lod_ranges).subspan((level - 1) * glyph_count(),glyph_count())};
+}
+
+//-----------------------------------------------------------------------------
+//	Returns the interleaved x,y vertices of a strip. The strips of glyph g
+//	are glyph_strips()[g].strip_index onwards.
+//-----------------------------------------------------------------------------
+template<typename T>
+inline std::span<const T>
+BasicFont<T>::strip(size_t strip_index) const noexcept
+{
+	const size_t first = m_strip_offsets[strip_index];
+	return std::span<const T>(m_strip_vertices).subspan(first * 2,(m_strip_offsets[strip_index + 1] - first) * 2);
+}
+
+template<typename T>
+inline typename BasicFont<T>::glyph_type
+BasicFont<T>::glyph(size_t index) const
+{
+	const auto & range = m_glyph_ranges[index];
+	return {m_glyph_codes[index],m_glyph_rects[index],range.parameter_index,range.primitive_index,range.primitive_count,m_glyph_advances[index]};
+}
+
+template<typename T>
+inline std::optional<typename BasicFont<T>::glyph_type>
+BasicFont<T>::get_glyph(uint32_t code) const
+{
+	const auto index = glyph_index(code);
+	if(index == NO_GLYPH)
+		return std::nullopt;
+	return glyph(index);
+}
+
+template<typename T>
+template<typename S, PrimitiveCallback<T> F>
+void
+BasicFont<T>::execute(const S & string, F && callback, GlyphHistogram & histogram) const
+{
+	for(uint32_t code : string)
 	{
-		parameters.push_back(x);
-		parameters.push_back(y);
-
-		Primitive primitive;
-		primitive.command = vectorfont::command::LINETO;
-		primitive.cap			= linecap;
-		primitives.push_back(primitive);
-
-		auto & glyph = glyphs.back();
-		glyph.primitive_count++;
-		glyph.rect.add(x,y);
-		rect.add(x,y);
+		histogram.record(code);
+		execute(code,callback);
 	}
 }
 
 template<typename T>
+template<typename S, PrimitiveCallback<T> F>
 void
-Font::execute(const T & string, std::function<bool(vectorfont::Primitive,std::span<const int16_t>)> callback) const
+BasicFont<T>::execute(const S & string, F && callback) const
 {
 	for(uint32_t code : string)
 		execute(code,callback);
 }
 
+template<typename T>
+template<PrimitiveCallback<T> F>
+void
+BasicFont<T>::execute_glyph(index_type index, F && callback, size_t level) const
+{
+	if(index != NO_GLYPH)
+	{
+		const auto	geom 		= geometry(level);
+		const auto & range 	= geom.glyph_ranges[index];
+		const T * 	p_param	= geom.parameters.data() + range.parameter_index;
+
+		for(const auto & primitive : geom.primitives.subspan(range.primitive_index,range.primitive_count))
+		{
+			const size_t pcount	= parameter_count(primitive);
+			const bool b_stop		= callback( primitive, std::span<const T>{p_param,pcount} );
+			p_param += pcount;
+			if(b_stop)
+				break;
+		}
+		callback(vectorfont::Primitive{vectorfont::command::ADVANCE},std::span<const T>{&m_glyph_advances[index],1});
+	}
+	else
+		callback(vectorfont::Primitive{vectorfont::command::ADVANCE},std::span<const T>{&m_missing_adv_x,1});
+}
+
+template<typename T>
+template<typename S, FontVisitor<T> V>
 void
-Font::execute(uint32_t code, std::function<bool(vectorfont::Primitive,std::span<const int16_t>)> callback) const
+BasicFont<T>::visit(const S & string, V & visitor) const
 {
-	const auto p_glyph = get_glyph(code);
-	if(p_glyph != nullptr)
+	for(uint32_t code : string)
+		visit(code,visitor);
+}
+
+template<typename T>
+template<FontVisitor<T> V>
+void
+BasicFont<T>::visit_glyph(index_type index, V & visitor) const
+{
+	if(index != NO_GLYPH)
 	{
-		auto glyph = *p_glyph;
+		const auto & range 	= m_glyph_ranges[index];
+		const T * p_param		= m_parameters.data() + range.parameter_index;
 
-		while(glyph.primitive_count-- > 0)
+		for(const auto primitive : std::span(m_primitives).subspan(range.primitive_index,range.primitive_count))
 		{
-			size_t pcount=0;
-			const auto & primitive 	= primitives[glyph.primitive_index++];
-			const auto & param			= parameters[glyph.parameter_index];
 			switch(primitive.command)
 			{
-				case vectorfont::command::MOVETO : pcount=2; glyph.parameter_index += 2; break;
-				case vectorfont::command::LINETO : pcount=2; glyph.parameter_index += 2; break;
+				case vectorfont::command::MOVETO : visitor.moveto(p_param[0],p_param[1]); 								break;
+				case vectorfont::command::LINETO : visitor.lineto(p_param[0],p_param[1],primitive.cap);	break;
+				default : break;
 			}
-			if(callback( primitive, {&param,pcount} ))
-				break;
+			p_param += parameter_count(primitive);
 		}
-		callback({vectorfont::command::ADVANCE},{&glyph.advance_x,1});
+		visitor.advance(m_glyph_advances[index]);
 	}
 	else
-		callback({vectorfont::command::ADVANCE},{&missing_adv_x,1});
+		visitor.advance(m_missing_adv_x);
 }
 
 
-template<typename T>	
-vectorfont::Rect
-Font::string_rect(const T& string) const
+template<typename T>
+template<typename S>
+Rectangle<typename BasicFont<T>::pen_type>
+BasicFont<T>::string_rect(const S& string) const
 {
-	vectorfont::Rect rect;
-	int16_t x = 0;
+	Rectangle<pen_type> rect;
+	pen_type x = 0;
 
 	for(uint32_t code : string)
 	{
-		const auto p_glyph = get_glyph(code);
-		if(p_glyph)
+		const auto index = glyph_index(code);
+		if(index != NO_GLYPH)
 		{
-			auto grect = p_glyph->rect;
+			Rectangle<pen_type> grect = m_glyph_rects[index];
 			grect.move_relative(x,0);
 			rect.add(grect);
-			x += p_glyph->advance_x;
+			x += m_glyph_advances[index];
 		}
 		else
-			x += missing_adv_x;		
+			x += m_missing_adv_x;		
 	}
 
 	return rect;
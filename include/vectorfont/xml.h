@@ -32,6 +32,9 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <memory_resource>
+#include <string_view>
+#include <type_traits>
 
 namespace ade { namespace xml 
 {
@@ -70,8 +73,19 @@ public:
 			CLOSE_SQUARE_BRACKET
 		};
 		
-		type_t			type;
-		std::string		text;
+		// The token text is allocated from the parser's memory resource, so
+		// the token is allocator aware to be copied into the token array.
+		using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+		type_t						type = UNKNOWN;
+		std::pmr::string	text;
+
+		explicit token_t(const allocator_type & alloc = {}) : text(alloc) {}
+		token_t(const token_t & other, const allocator_type & alloc = {}) : type(other.type), text(other.text,alloc) {}
+		token_t(token_t && other) = default;
+		token_t(token_t && other, const allocator_type & alloc) : type(other.type), text(std::move(other.text),alloc) {}
+		token_t & operator=(const token_t & other) = default;
+		token_t & operator=(token_t && other) = default;
 	};
 
 	enum Encoding 
@@ -84,15 +98,15 @@ public:
 		ENCODING_UTF32_BIG_ENDIAN
 	};
 
-	typedef std::vector<token_t>									token_array_t;
-	typedef std::vector<token_t>::iterator				iterator;
-	typedef std::vector<token_t>::const_iterator	const_iterator;
+	typedef std::pmr::vector<token_t>									token_array_t;
+	typedef std::pmr::vector<token_t>::iterator				iterator;
+	typedef std::pmr::vector<token_t>::const_iterator	const_iterator;
 
 private:
 	std::uint8_t *												m_p_buffer;
 	std::uint8_t *												m_p_buffer_end;
 	std::uint8_t *												m_p_current_position;
-	std::map<std::string,unsigned long>		m_char_entities;
+	std::pmr::map<std::pmr::string,unsigned long,std::less<>>	m_char_entities;
 	token_array_t													m_tokens;
 	Encoding															m_encoding = ENCODING_PLAIN_TEXT;
 
@@ -165,13 +179,13 @@ private:
 	void reset_char_entities()
 	{
 		m_char_entities.clear();
-		m_char_entities["quot"]		= 0x0022;
-		m_char_entities["amp"]		= 0x0026;
-		m_char_entities["apos"]		= 0x0027;
-		m_char_entities["lt"]			= 0x003C;
-		m_char_entities["gt"]			= 0x003E;
-		m_char_entities["#163"]		= 0x00A3;
-		m_char_entities["euro"]		= 0x0080;
+		m_char_entities.emplace("quot",	0x0022);
+		m_char_entities.emplace("amp",	0x0026);
+		m_char_entities.emplace("apos",	0x0027);
+		m_char_entities.emplace("lt",		0x003C);
+		m_char_entities.emplace("gt",		0x003E);
+		m_char_entities.emplace("#163",	0x00A3);
+		m_char_entities.emplace("euro",	0x0080);
 	}
 
 	//-------------------------------------------------------------------------
@@ -179,7 +193,7 @@ private:
 	//-------------------------------------------------------------------------
 	int	parse_tokens(token_array_t & tokens)
 	{
-		token_t tok;
+		token_t tok(tokens.get_allocator());
 		bool finished = false;
 		bool err = false;
 
@@ -378,7 +392,7 @@ private:
 		if(ch != '&')
 			return ch;
 
-		std::string entity;
+		std::pmr::string entity(m_tokens.get_allocator());
 		
 		for(;;)
 		{
@@ -411,7 +425,7 @@ private:
 	//-------------------------------------------------------------------------
 	//	PARSE STRING
 	//-------------------------------------------------------------------------
-	int	parse_string(std::string & result)
+	int	parse_string(std::pmr::string & result)
 	{
 		bool quotes = false;
 		bool finished = false;
@@ -559,10 +573,12 @@ public:
 	XMLParser( const XMLParser& ) = delete;
 	const XMLParser& operator=( const XMLParser& ) = delete;
 
-	XMLParser(char * pbuffer,size_t buffer_size) :
+	XMLParser(char * pbuffer,size_t buffer_size,std::pmr::memory_resource * p_resource = std::pmr::get_default_resource()) :
 		m_p_buffer((std::uint8_t *)pbuffer),
 		m_p_buffer_end((std::uint8_t *)(pbuffer+buffer_size)),
-		m_p_current_position((std::uint8_t *)pbuffer)
+		m_p_current_position((std::uint8_t *)pbuffer),
+		m_char_entities(p_resource),
+		m_tokens(p_resource)
 	{
 		assert(pbuffer);
 		assert(m_p_buffer_end);
@@ -570,8 +586,6 @@ public:
 		reset_char_entities();
 		read_byte_order_mark();
 
-		token_t	token;
-
 		parse_tokens(m_tokens);
 	}
 
@@ -842,6 +856,11 @@ public:
 
 class XMLElement;
 
+//-----------------------------------------------------------------------------
+//	Nodes, and their strings, are allocated from the memory resource of the
+//	document. A node is deleted with destroy(), which returns it to the
+//	resource that it was allocated from.
+//-----------------------------------------------------------------------------
 class XMLNode
 {
 public:
@@ -853,17 +872,38 @@ public:
 		COMMENT
 	} type_t;
 
-	virtual type_t				type() const = 0;
-	virtual	const std::string & value() const = 0;
-	virtual void				find_children(const std::string & name,std::function<bool(const XMLNode *)> ) const = 0;
-	virtual void				find_elements(const std::string & name,std::function<bool(const XMLElement *)> ) const = 0;
-	virtual void				write(std::ostream & os,int indent = -1) const = 0;
+	using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+	virtual type_t								type() const = 0;
+	virtual	const std::pmr::string &	value() const = 0;
+	virtual void									find_children(std::string_view name,std::function<bool(const XMLNode *)> ) const = 0;
+	virtual void									find_elements(std::string_view name,std::function<bool(const XMLElement *)> ) const = 0;
+	virtual void									write(std::ostream & os,int indent = -1) const = 0;
+	virtual void									destroy() = 0;
 
 	XMLNode() {}
 	virtual ~XMLNode() {}
 
 };
 
+struct XMLNodeDeleter
+{
+	void operator()(XMLNode * p_node) const {p_node->destroy();}
+};
+
+using node_ptr = std::unique_ptr<XMLNode,XMLNodeDeleter>;
+
+//-----------------------------------------------------------------------------
+//	Allocates a node of type T from the allocator. The allocator is passed on
+//	to the node's constructor.
+//-----------------------------------------------------------------------------
+template<typename T,typename...Args>
+node_ptr
+make_node(XMLNode::allocator_type alloc,Args && ... args)
+{
+	return node_ptr(alloc.template new_object<T>(std::forward<Args>(args)...));
+}
+
 //=============================================================================
 //
 //	TEXT
@@ -873,17 +913,19 @@ public:
 class XMLText : public XMLNode
 {
 private:
-	std::string		m_text;
+	std::pmr::string		m_text;
 
 public:
-	XMLText(const std::string & text) :	m_text(text){}
+	XMLText(std::string_view text,const allocator_type & alloc = {}) :	m_text(text,alloc){}
 	virtual ~XMLText() {}
 
-	const std::string & value() const override {return m_text;}
-	type_t				type() const override {return TEXT;}
-	void				find_children(const std::string & /*name*/,std::function<bool(const XMLNode *)>) const override {}
-	void				find_elements(const std::string & /*name*/,std::function<bool(const XMLElement *)>) const override {}
-	void				write(std::ostream & os,int /*indent*/) const override	{os << m_text << "\n";}
+	allocator_type							get_allocator() const {return m_text.get_allocator();}
+	const std::pmr::string &		value() const override {return m_text;}
+	type_t											type() const override {return TEXT;}
+	void												find_children(std::string_view /*name*/,std::function<bool(const XMLNode *)>) const override {}
+	void												find_elements(std::string_view /*name*/,std::function<bool(const XMLElement *)>) const override {}
+	void												write(std::ostream & os,int /*indent*/) const override	{os << m_text << "\n";}
+	void												destroy() override {get_allocator().delete_object(this);}
 };
 
 //=============================================================================
@@ -895,9 +937,9 @@ public:
 class XMLElement : public XMLNode
 {
 private:
-	std::string									m_name;
-	std::vector<std::unique_ptr<XMLNode>>		m_children;
-	std::map<std::string,std::string>			m_attributes;
+	std::pmr::string															m_name;
+	std::pmr::vector<node_ptr>										m_children;
+	std::pmr::map<std::pmr::string,std::pmr::string,std::less<>>	m_attributes;
 
 private:
 	long stringtolong(const char * str,size_t size) const
@@ -957,8 +999,10 @@ private:
 	}
 
 public:
-	XMLElement(const std::string & element_name) :
-		m_name(element_name)
+	XMLElement(std::string_view element_name,const allocator_type & alloc = {}) :
+		m_name(element_name,alloc),
+		m_children(alloc),
+		m_attributes(alloc)
 		{}
 
 	virtual ~XMLElement()
@@ -966,10 +1010,12 @@ public:
 		m_children.clear();	
 	}
 
-	const std::string & value() const override	{return m_name;}
-	type_t				type() const override	{return ELEMENT;}
+	allocator_type							get_allocator() const	{return m_name.get_allocator();}
+	const std::pmr::string &		value() const override	{return m_name;}
+	type_t											type() const override	{return ELEMENT;}
+	void												destroy() override		{get_allocator().delete_object(this);}
 
-	void		push_back(std::unique_ptr<XMLNode> && p_node)	{m_children.push_back(std::forward<std::unique_ptr<XMLNode>>(p_node));}
+	void		push_back(node_ptr && p_node)	{m_children.push_back(std::move(p_node));}
 
 	std::string escape_string(const char * str,size_t size) const
 	{
@@ -994,9 +1040,9 @@ public:
 		return escstr;
 	}
 
-	std::string escape_string(const std::string & str) const
+	std::string escape_string(std::string_view str) const
 	{
-		return escape_string(str.c_str(),str.size());
+		return escape_string(str.data(),str.size());
 	}
 
 	void write(std::ostream & os,int indent) const override
@@ -1036,17 +1082,21 @@ public:
 	//----------------------------------------------------------------------------
 	//	ATRRIBUTES
 	//----------------------------------------------------------------------------
-	template<typename T> void set_attribute(const std::string & name,T value)
+	template<typename T> requires std::is_arithmetic_v<T> void set_attribute(std::string_view name,T value)
 	{
-		m_attributes[name] = std::to_string(value);
+		set_attribute(name,std::string_view(std::to_string(value)));
 	}
 
-	void set_attribute(const std::string & name,const std::string & value)
+	void set_attribute(std::string_view name,std::string_view value)
 	{
-		m_attributes[name] = value;
+		auto ifind = m_attributes.find(name);
+		if(ifind == m_attributes.end())
+			m_attributes.emplace(name,value);
+		else
+			ifind->second.assign(value);
 	}
 
-	bool get_attribute(const std::string & name,unsigned long & value) const
+	bool get_attribute(std::string_view name,unsigned long & value) const
 	{
 		auto ifind = m_attributes.find(name);
 		if(ifind==m_attributes.end())
@@ -1055,7 +1105,7 @@ public:
 		return true;
 	}
 
-	bool get_attribute(const std::string & name,long & value) const
+	bool get_attribute(std::string_view name,long & value) const
 	{
 		auto ifind = m_attributes.find(name);
 		if(ifind==m_attributes.end())
@@ -1064,7 +1114,7 @@ public:
 		return true;
 	}
 
-	bool get_attribute(const std::string & name,unsigned int & value) const
+	bool get_attribute(std::string_view name,unsigned int & value) const
 	{
 		auto ifind = m_attributes.find(name);
 		if(ifind==m_attributes.end())
@@ -1073,7 +1123,7 @@ public:
 		return true;
 	}
 
-	bool get_attribute(const std::string & name,int & value) const
+	bool get_attribute(std::string_view name,int & value) const
 	{
 		auto ifind = m_attributes.find(name);
 		if(ifind==m_attributes.end())
@@ -1082,7 +1132,7 @@ public:
 		return true;
 	}
 
-	bool get_attribute(const std::string & name,unsigned short & value) const
+	bool get_attribute(std::string_view name,unsigned short & value) const
 	{
 		auto ifind = m_attributes.find(name);
 		if(ifind==m_attributes.end())
@@ -1091,7 +1141,7 @@ public:
 		return true;
 	}
 
-	bool get_attribute(const std::string & name,short & value) const
+	bool get_attribute(std::string_view name,short & value) const
 	{
 		auto ifind = m_attributes.find(name);
 		if(ifind==m_attributes.end())
@@ -1100,7 +1150,7 @@ public:
 		return true;
 	}
 
-	bool get_attribute(const std::string & name,float & value) const
+	bool get_attribute(std::string_view name,float & value) const
 	{
 		auto ifind = m_attributes.find(name);
 		if(ifind==m_attributes.end())
@@ -1109,29 +1159,38 @@ public:
 		return true;
 	}
 
-	bool get_attribute(const std::string & name,bool & value) const
+	bool get_attribute(std::string_view name,bool & value) const
 	{
 		auto ifind = m_attributes.find(name);
 		if(ifind==m_attributes.end())
 			return false;
 
-		std::string boolval = ifind->second;
+		std::string boolval(ifind->second);
 		std::transform(boolval.begin(),boolval.end(),boolval.begin(),::tolower);
 
 		value = !!((boolval=="1") || (boolval=="true") || (boolval=="yes"));
 		return true;
 	}
 
-	bool get_attribute(const std::string & name,std::string & out_attribute) const
+	bool get_attribute(std::string_view name,std::string & out_attribute) const
 	{
 		auto ifind = m_attributes.find(name);	
 		if(ifind == m_attributes.end())
 			return false;
-		out_attribute = ifind->second;
+		out_attribute.assign(ifind->second);
 		return true;
 	}
 
-	void get_attributes(std::function<bool(const std::string & name,const std::string & value)> func) const 
+	bool get_attribute(std::string_view name,std::pmr::string & out_attribute) const
+	{
+		auto ifind = m_attributes.find(name);	
+		if(ifind == m_attributes.end())
+			return false;
+		out_attribute.assign(ifind->second);
+		return true;
+	}
+
+	void get_attributes(std::function<bool(const std::pmr::string & name,const std::pmr::string & value)> func) const
 	{
 		for(auto & attrpair : m_attributes)
 			if(func(attrpair.first,attrpair.second))
@@ -1157,7 +1216,7 @@ public:
 		return p_found;
 	}
 
-	const XMLElement * get_element(const std::string & id) const 
+	const XMLElement * get_element(std::string_view id) const
 	{
 		const XMLElement * p_found = nullptr;
 
@@ -1198,7 +1257,7 @@ public:
 		return count;
 	}
 
-	void find_children(const std::string & name,std::function<bool(const XMLNode *)> func) const override
+	void find_children(std::string_view name,std::function<bool(const XMLNode *)> func) const override
 	{
 		for(auto & p_child : m_children)
 			if(p_child && (name.empty() || p_child->value() == name))
@@ -1206,7 +1265,7 @@ public:
 					break;
 	}
 
-	void find_elements(const std::string & name,std::function<bool(const XMLElement *)> func) const override
+	void find_elements(std::string_view name,std::function<bool(const XMLElement *)> func) const override
 	{
 		for(auto & p_child : m_children)
 			if(p_child && (p_child->type() == XMLNode::ELEMENT))
@@ -1230,7 +1289,7 @@ public:
 		return count;
 	}
 
-	int get_element_text(const std::string & element_name,std::string & out_text) const
+	int get_element_text(std::string_view element_name,std::string & out_text) const
 	{
 		int result = 0;
 
@@ -1255,16 +1314,18 @@ public:
 class XMLComment : public XMLNode
 {
 private:
-	std::string		m_comment;
+	std::pmr::string		m_comment;
 
 public:
-	XMLComment(const std::string & text) :	m_comment(text) {}
+	XMLComment(std::string_view text,const allocator_type & alloc = {}) :	m_comment(text,alloc) {}
 	virtual ~XMLComment() = default;
 
-	const std::string & value() const override {return m_comment;}
-	type_t				type() const override {return COMMENT;}
-	void				find_children(const std::string & /*name*/,std::function<bool(const XMLNode *)>) const override {}
-	void				find_elements(const std::string & /*name*/,std::function<bool(const XMLElement *)>) const override {}
+	allocator_type							get_allocator() const {return m_comment.get_allocator();}
+	const std::pmr::string &		value() const override {return m_comment;}
+	type_t											type() const override {return COMMENT;}
+	void												find_children(std::string_view /*name*/,std::function<bool(const XMLNode *)>) const override {}
+	void												find_elements(std::string_view /*name*/,std::function<bool(const XMLElement *)>) const override {}
+	void												destroy() override {get_allocator().delete_object(this);}
 
 	void write(std::ostream & os,int indent) const override
 	{
@@ -1279,26 +1340,36 @@ public:
 //
 //=============================================================================
 
+//-----------------------------------------------------------------------------
+//	The tokens and nodes of the document are allocated from the memory
+//	resource passed to the constructor. The DTD of a DOCTYPE declaration is
+//	not part of the node tree and uses the global heap.
+//-----------------------------------------------------------------------------
 class XMLDocument : public XMLElement
 {
 
 private:
-	std::vector<std::string>			m_errors;
-	std::string							m_xml_version;
-	std::string							m_encoding;
+	std::pmr::vector<std::pmr::string>	m_errors;
+	std::pmr::string										m_xml_version;
+	std::pmr::string										m_encoding;
 	std::shared_ptr<IResourceFactory>	m_p_resource_factory;
 	DocType								m_doctype;
 
 
 public:
 
-	XMLDocument()
-		: XMLElement("")
+	explicit XMLDocument(std::pmr::memory_resource * p_resource = std::pmr::get_default_resource())
+		: XMLElement("",p_resource),
+			m_errors(p_resource),
+			m_xml_version(p_resource),
+			m_encoding(p_resource)
 	{
 	}
 
 	virtual ~XMLDocument() {}
 
+	void destroy() override	{get_allocator().delete_object(this);}
+
 	void set_resource_factory(std::shared_ptr<IResourceFactory>	p_resource_factory)
 	{
 		m_p_resource_factory = p_resource_factory;
@@ -1309,9 +1380,9 @@ public:
 		m_errors.clear();
 	}
 
-	void error(const std::string & errstr)
+	void error(std::string_view errstr)
 	{
-		m_errors.push_back(errstr);
+		m_errors.emplace_back(errstr);
 	}
 
 	std::string get_error_string() const 
@@ -1327,8 +1398,8 @@ public:
 		return errors;
 	}
 
-	const std::string & get_xml_version()	{return m_xml_version;}
-	const std::string & get_encoding()		{return m_encoding;}
+	const std::pmr::string & get_xml_version()	{return m_xml_version;}
+	const std::pmr::string & get_encoding()		{return m_encoding;}
 
 	const XMLElement * get_root_element()	{return static_cast<const XMLElement *>(get_first(XMLNode::ELEMENT));}
 
@@ -1469,8 +1540,8 @@ public:
 						case	XMLParser::token_t::STRING :
 						//-----------------------------------------------------
 							{
-								auto p_element = std::make_unique<XMLElement>(ib->text);
-								//std::unique_ptr<XMLElement> p_element(new XMLElement{ib->text});
+								auto p_node = make_node<XMLElement>(get_allocator(),ib->text);
+								auto p_element = static_cast<XMLElement *>(p_node.get());
 								if(p_element)
 								{
 									++ib;
@@ -1512,15 +1583,15 @@ public:
 									{
 										if(ib->type == XMLParser::token_t::CLOSE_ELEMENT)
 										{
-											pparent->push_back(std::move(p_element));
+											pparent->push_back(std::move(p_node));
 											++ib;
 										}
 										else
 										{
 											++ib;
-											parse_tokens(ib,ie,err,p_element.get());
+											parse_tokens(ib,ie,err,p_element);
 											if(!err)
-												pparent->push_back(std::move(p_element));
+												pparent->push_back(std::move(p_node));
 										}
 									}
 								}
@@ -1570,7 +1641,7 @@ public:
 						{
 							if(ib->type==XMLParser::token_t::STRING)
 							{
-								auto type = ib->text;
+								std::pmr::string type(ib->text,get_allocator());
 								std::transform(std::begin(type),std::end(type),std::begin(type),::tolower);
 
 								++ib;
@@ -1587,7 +1658,7 @@ public:
 										((ib+1)->type==XMLParser::token_t::EQUALS) &&
 										((ib+2)->type==XMLParser::token_t::STRING) )
 									{
-										auto id		= ib->text;
+										std::pmr::string id(ib->text,get_allocator());
 										auto & val	= (ib+2)->text;
 
 										std::transform(std::begin(id),std::end(id),std::begin(id),::tolower);
@@ -1617,20 +1688,20 @@ public:
 				case	XMLParser::token_t::START_COMMENT :
 				//-------------------------------------------------------------
 					{
-						std::string comment;
+						std::pmr::string comment(get_allocator());
 						while((ib!=ie) && (ib->type!=XMLParser::token_t::END_COMMENT))
 						{
 							if(	(ib->type == XMLParser::token_t::STRING) || 
 								(ib->type == XMLParser::token_t::TEXT) ||
 								(ib->type == XMLParser::token_t::WHITE_SPACE) )
-								comment = comment+ib->text;
+								comment.append(ib->text);
 							++ib;
 						}
 						if(ib==ie)
 							err = true;
 						else
 						{
-							auto p_comment = std::make_unique<XMLComment>(comment);
+							auto p_comment = make_node<XMLComment>(get_allocator(),comment);
 							if(p_comment)
 							{
 								pparent->push_back(std::move(p_comment));
@@ -1680,11 +1751,10 @@ public:
 				case	XMLParser::token_t::TEXT :
 				//-------------------------------------------------------------
 					{
-						auto p_text = std::make_unique<XMLText>(ib->text);
+						auto p_text = make_node<XMLText>(get_allocator(),ib->text);
 						if(p_text)
 						{
-							std::unique_ptr<XMLText> p_new_text(new XMLText{ib->text});
-							pparent->push_back(std::move(p_new_text));
+							pparent->push_back(std::move(p_text));
 							++ib;
 						} 
 						else
@@ -1820,7 +1890,7 @@ public:
 							if(	(ib->type == XMLParser::token_t::STRING) || 
 								(ib->type == XMLParser::token_t::TEXT) ||
 								(ib->type == XMLParser::token_t::WHITE_SPACE) )
-								comment = comment+ib->text;
+								comment.append(ib->text);
 							++ib;
 						}
 
@@ -1893,7 +1963,7 @@ public:
 	{
 		clear();
 		
-		XMLParser parser((char *)pdata,size);
+		XMLParser parser((char *)pdata,size,get_allocator().resource());
 
 		if(parser.empty())
 			return 0;
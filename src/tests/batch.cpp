@@ -0,0 +1,51 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+#include <atomic>
+#include "vectorfont/batch.h"
+#include "vectorfont/hershey.h"
+#include "test_font.h"
+
+TEST_CASE( "Parallel loops", "[batch-executor]")
+{
+	vectorfont::BatchExecutor executor(4);
+	REQUIRE( executor.thread_count() == 4 );
+
+	for(size_t count : {size_t(0),size_t(1),vectorfont::BatchExecutor::CHUNK_SIZE * 3 + 5,size_t(10000)})
+	{
+		std::vector<std::atomic<int>> calls(count);
+		executor.parallel_for(count,[&](size_t i) {++calls[i];});
+		for(const auto & call : calls)
+			REQUIRE( call == 1 );
+	}
+}
+
+TEST_CASE( "Batch layout", "[batch-layout]")
+{
+	auto p_font = vectorfont::parse_hershey_font(test_font_svg);
+	REQUIRE( p_font != nullptr );
+
+	const std::vector<std::string> strings{"A","I-","?","AAI"};
+	std::vector<vectorfont::LabelJob> jobs;
+	for(size_t i = 0; i < 1000; ++i)
+		jobs.push_back({i % 7 ? p_font.get() : nullptr,strings[i % strings.size()],vectorfont::Affine::translation(static_cast<float>(i),0.0f)});
+
+	vectorfont::BatchExecutor executor(3);
+	vectorfont::SegmentBatch batch;
+	const auto total = vectorfont::layout_segments_batch(executor,jobs,batch);
+	REQUIRE( total == batch.size() );
+	REQUIRE( batch.job_offsets.size() == jobs.size() + 1 );
+
+	for(size_t i = 0; i < jobs.size(); ++i)
+	{
+		const auto count = jobs[i].p_font ? vectorfont::layout_size(*p_font,jobs[i].string).segments : 0;
+		REQUIRE( batch.job_offsets[i + 1] - batch.job_offsets[i] == count );
+
+		std::vector<float> x0(count), y0(count), x1(count), y1(count);
+		if(count)
+			vectorfont::layout_segments(*p_font,jobs[i].string,vectorfont::SegmentBuffers<float>{x0,y0,x1,y1},jobs[i].affine);
+		const auto buffers = batch.buffers(i);
+		REQUIRE( std::vector<float>(buffers.x0.begin(),buffers.x0.end()) == x0 );
+		REQUIRE( std::vector<float>(buffers.y1.begin(),buffers.y1.end()) == y1 );
+	}
+}
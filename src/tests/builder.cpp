@@ -0,0 +1,218 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <string_view>
+#include <memory>
+#include <memory_resource>
+#include <array>
+#include "vectorfont/builder.h"
+#include "vectorfont/hershey.h"
+#include "vectorfont/xml.h"
+#include "test_font.h"
+
+TEST_CASE( "Building a font", "[builder]")
+{
+	vectorfont::FontBuilder builder;
+	builder.set_id("built");
+	builder.set_metrics(24,-8,32);
+	builder.set_missing_advance(8);
+	builder.start_glyph('L',12);
+	builder.moveto(1,20);
+	builder.lineto(1,0);
+	builder.lineto(10,0,vectorfont::cap::SQUARE);
+
+	std::shared_ptr<const vectorfont::Font> p_font = builder.build();
+	REQUIRE( builder.glyph_count() == 0 );
+
+	REQUIRE( p_font->id() == "built" );
+	REQUIRE( p_font->units_per_em() == 32 );
+	REQUIRE( p_font->missing_adv_x() == 8 );
+	REQUIRE( p_font->primitives().size() == 3 );
+	REQUIRE( p_font->primitives()[2].cap == vectorfont::cap::SQUARE );
+	REQUIRE( p_font->get_glyph('L')->rect.right == 10 );
+	REQUIRE( p_font->rect().bottom == 20 );
+	REQUIRE( p_font->parameters().size() == 6 );
+}
+
+TEST_CASE( "Glyph reordering", "[font-reorder]")
+{
+	auto p_font = vectorfont::parse_hershey_font(test_font_svg);
+	REQUIRE( p_font != nullptr );
+
+	auto collect = [&](const std::string & text)
+	{
+		std::vector<int16_t> output;
+		p_font->execute(text,[&](vectorfont::Primitive primitive, std::span<const int16_t> args)->bool
+			{
+				output.push_back(primitive.command);
+				output.insert(output.end(),args.begin(),args.end());
+				return false;
+			});
+		return output;
+	};
+
+	const std::string text = "-IA -I";
+	const auto before = collect(text);
+
+	vectorfont::GlyphHistogram histogram;
+	p_font->execute(std::string("I-I-I"),[](vectorfont::Primitive,std::span<const int16_t>){return false;},histogram);
+	REQUIRE( histogram.count('I') == 3 );
+	REQUIRE( histogram.count('-') == 2 );
+
+	vectorfont::FontBuilder builder(*p_font);
+	builder.reorder(histogram);
+	p_font = builder.build();
+
+	REQUIRE( p_font->glyph_codes()[0] == 'I' );
+	REQUIRE( p_font->glyph_codes()[1] == '-' );
+	REQUIRE( p_font->glyph_ranges()[0].parameter_index == 0 );
+	REQUIRE( p_font->glyph_ranges()[1].primitive_index == 2 );
+	REQUIRE( p_font->glyph(p_font->glyph_index('A')).primitive_count == 5 );
+	REQUIRE( collect(text) == before );
+}
+
+TEST_CASE( "Index capacity", "[font-capacity]")
+{
+	vectorfont::FontBuilder builder;
+	bool b_ok = builder.start_glyph('A',10);
+
+	for(int i = 0; b_ok && (i < 40000); ++i)
+		b_ok = builder.lineto(static_cast<int16_t>(i & 0xFF),0);
+
+	if constexpr (sizeof(vectorfont::index_type) == 2)
+	{
+		REQUIRE_FALSE( b_ok );
+		REQUIRE( builder.font().parameters().size() <= vectorfont::Font::MAX_INDEX );
+	}
+	else
+	{
+		REQUIRE( b_ok );
+		REQUIRE( builder.start_glyph('B',10) );
+		REQUIRE( builder.moveto(1,2) );
+		const auto p_font = builder.build();
+
+		REQUIRE( p_font->get_glyph('A')->primitive_count == 40000 );
+		const auto glyph = *p_font->get_glyph('B');
+		REQUIRE( glyph.parameter_index == 80000 );
+		REQUIRE( p_font->parameters()[glyph.parameter_index + 1] == 2 );
+	}
+}
+
+
+TEST_CASE( "Geometry deduplication", "[font-dedup]")
+{
+	auto p_font = vectorfont::parse_hershey_font(test_font_svg);
+	REQUIRE( p_font != nullptr );
+
+	// Map the same outline to another code and add a near copy that must not be merged.
+	vectorfont::FontBuilder builder(*p_font);
+	builder.start_glyph(0x2010,12);
+	builder.moveto(2,10);
+	builder.lineto(10,10);
+	builder.start_glyph(0x2011,12);
+	builder.moveto(2,10);
+	builder.lineto(10,10,vectorfont::cap::SQUARE);
+
+	const auto parameter_count = builder.font().parameters().size();
+	const auto saved = builder.deduplicate();
+	REQUIRE( builder.deduplicate() == 0 );
+	p_font = builder.build();
+
+	REQUIRE( saved == 4 * sizeof(int16_t) + 2 * sizeof(vectorfont::Primitive) );
+	REQUIRE( p_font->parameters().size() == parameter_count - 4 );
+
+	const auto hyphen = *p_font->get_glyph('-');
+	const auto dash = *p_font->get_glyph(0x2010);
+	const auto square = *p_font->get_glyph(0x2011);
+	REQUIRE( hyphen.primitive_index == dash.primitive_index );
+	REQUIRE( hyphen.parameter_index == dash.parameter_index );
+	REQUIRE( square.primitive_index != dash.primitive_index );
+}
+
+TEST_CASE( "Memory usage", "[builder-memory]")
+{
+	auto p_font = vectorfont::parse_hershey_font(test_font_svg);
+	REQUIRE( p_font != nullptr );
+
+	const auto usage = p_font->memory_usage();
+	const auto glyph_bytes = sizeof(uint32_t) + sizeof(int16_t) + sizeof(vectorfont::GlyphRange) + sizeof(vectorfont::Rect);
+	REQUIRE( usage.glyphs == p_font->glyph_count() * glyph_bytes );
+	REQUIRE( usage.primitives == p_font->primitives().size() * sizeof(vectorfont::Primitive) );
+	REQUIRE( usage.parameters == p_font->parameters().size() * sizeof(int16_t) );
+	REQUIRE( usage.index == vectorfont::GlyphIndex::LOOKUP_SIZE * sizeof(vectorfont::index_type) + sizeof(uint32_t) + sizeof(vectorfont::index_type) );
+	REQUIRE( usage.strips == p_font->strip_vertices().size() * sizeof(int16_t) + p_font->strip_offsets().size() * sizeof(vectorfont::index_type) + p_font->glyph_strips().size() * sizeof(vectorfont::GlyphStrips) );
+	REQUIRE( usage.total() == usage.glyphs + usage.primitives + usage.parameters + usage.index + usage.strips + usage.other );
+
+	vectorfont::FontBuilder builder;
+	builder.reserve(64,256,512);
+	builder.start_glyph('L',12);
+	builder.moveto(1,20);
+	builder.lineto(1,0);
+	REQUIRE( builder.font().memory_usage().primitives == 256 * sizeof(vectorfont::Primitive) );
+
+	p_font = builder.build();
+	REQUIRE( p_font->memory_usage().primitives == 2 * sizeof(vectorfont::Primitive) );
+	REQUIRE( p_font->memory_usage().parameters == 4 * sizeof(int16_t) );
+}
+
+namespace
+{
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+	size_t allocations = 0;
+
+private:
+	void * do_allocate(size_t bytes, size_t alignment) override 		{++allocations; return std::pmr::new_delete_resource()->allocate(bytes,alignment);}
+	void do_deallocate(void * p, size_t bytes, size_t alignment) override	{std::pmr::new_delete_resource()->deallocate(p,bytes,alignment);}
+	bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override {return this == &other;}
+};
+}
+
+TEST_CASE( "Memory resources", "[builder-pmr]")
+{
+	CountingResource default_resource;
+	auto p_previous = std::pmr::set_default_resource(&default_resource);
+
+	{
+		std::pmr::monotonic_buffer_resource arena(std::pmr::new_delete_resource());
+		auto p_font = vectorfont::parse_hershey_font(test_font_svg,&arena);
+		REQUIRE( p_font != nullptr );
+		REQUIRE( p_font->get_allocator().resource() == &arena );
+		REQUIRE( p_font->code_index().get_allocator().resource() == &arena );
+
+		vectorfont::FontBuilder builder(*p_font,&arena);
+		builder.deduplicate();
+		auto p_copy = builder.build();
+		REQUIRE( p_copy->get_allocator().resource() == &arena );
+		REQUIRE( p_copy->get_glyph('A')->primitive_count == 5 );
+	}
+
+	std::pmr::set_default_resource(p_previous);
+	REQUIRE( default_resource.allocations == 0 );
+}
+
+TEST_CASE( "Loading allocates only from the memory resource", "[builder-pmr]")
+{
+	CountingResource default_resource;
+	auto p_previous = std::pmr::set_default_resource(&default_resource);
+
+	{
+		std::array<std::byte,64 * 1024> buffer;
+		std::pmr::monotonic_buffer_resource arena(buffer.data(),buffer.size(),std::pmr::null_memory_resource());
+
+		const std::string_view svg(test_font_svg);
+		ade::xml::XMLDocument doc(&arena);
+		REQUIRE( doc.parse(svg.data(),svg.size()) == 0 );
+		auto p_root = doc.get_root_element();
+		REQUIRE( p_root != nullptr );
+		REQUIRE( p_root->get_allocator().resource() == &arena );
+		REQUIRE( p_root->value() == "svg" );
+
+		auto p_font = vectorfont::parse_hershey_font(test_font_svg,&arena);
+		REQUIRE( p_font != nullptr );
+		REQUIRE( p_font->glyph_count() == 4 );
+	}
+
+	std::pmr::set_default_resource(p_previous);
+	REQUIRE( default_resource.allocations == 0 );
+}
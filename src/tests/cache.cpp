@@ -0,0 +1,81 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+#include <thread>
+#include <memory>
+#include "vectorfont/cache.h"
+#include "vectorfont/hershey.h"
+#include "test_font.h"
+
+TEST_CASE( "Scaled glyph cache", "[cache]")
+{
+	std::shared_ptr<const vectorfont::Font> p_font = vectorfont::parse_hershey_font(test_font_svg);
+	REQUIRE( p_font != nullptr );
+
+	vectorfont::GlyphCache cache;
+	const auto p_scaled = cache.get_size(p_font,16);
+	REQUIRE( p_scaled->scale() == 0.5f );
+	REQUIRE( cache.get(p_font,0.5f) == p_scaled );
+	REQUIRE( cache.get(p_font,2.0f) != p_scaled );
+	REQUIRE( cache.size() == 2 );
+
+	const auto memory_before = p_scaled->memory_usage();
+	const auto p_glyph = p_scaled->glyph('A');
+	REQUIRE( p_glyph != nullptr );
+	REQUIRE( p_scaled->glyph('A') == p_glyph );
+	REQUIRE( p_scaled->glyph('?') == nullptr );
+	REQUIRE( p_scaled->memory_usage() > memory_before );
+
+	REQUIRE( p_glyph->advance_x == 9 );
+	REQUIRE( p_glyph->primitives.size() == 5 );
+	REQUIRE( p_glyph->parameters == std::vector<int32_t>{0,0,4,10,8,0,2,4,7,4} );
+	REQUIRE( p_glyph->rect.right == 8 );
+	REQUIRE( p_glyph->rect.bottom == 10 );
+
+	std::vector<int32_t> output;
+	p_scaled->execute(std::string("?I"),100,50,[&](vectorfont::Primitive primitive, std::span<const int32_t> args)
+		{
+			output.push_back(primitive.command);
+			output.insert(output.end(),args.begin(),args.end());
+			return false;
+		});
+	using namespace vectorfont::command;
+	REQUIRE( output == std::vector<int32_t>{ADVANCE,4,MOVETO,106,50,LINETO,106,60,ADVANCE,3} );
+
+	SECTION( "Glyphs can be flipped for a y-down target" )
+	{
+		const auto p_down = cache.get_size(p_font,16,true);
+		REQUIRE( p_down != p_scaled );
+		REQUIRE( p_down->is_y_down() );
+		REQUIRE( p_down->glyph('A')->parameters == std::vector<int32_t>{0,0,4,-10,8,0,2,-4,7,-4} );
+		REQUIRE( p_down->glyph('A')->rect.top == -10 );
+
+		output.clear();
+		p_down->execute(std::string("I"),100,50,[&](vectorfont::Primitive primitive, std::span<const int32_t> args)
+			{
+				output.push_back(primitive.command);
+				output.insert(output.end(),args.begin(),args.end());
+				return false;
+			});
+		REQUIRE( output == std::vector<int32_t>{MOVETO,102,50,LINETO,102,40,ADVANCE,3} );
+	}
+
+	SECTION( "Glyphs can be built from several threads" )
+	{
+		const auto p_shared = cache.get(p_font,3.0f);
+		std::vector<std::thread> threads;
+		std::vector<const vectorfont::ScaledGlyph *> glyphs(8);
+		for(size_t i = 0; i < glyphs.size(); ++i)
+			threads.emplace_back([&,i]{glyphs[i] = p_shared->glyph(0x4E00);});
+		for(auto & thread : threads)
+			thread.join();
+
+		for(const auto p_thread_glyph : glyphs)
+			REQUIRE( p_thread_glyph == glyphs.front() );
+		REQUIRE( glyphs.front()->parameters == std::vector<int32_t>{6,36,90,36} );
+	}
+
+	cache.clear();
+	REQUIRE( cache.size() == 0 );
+	REQUIRE( p_scaled->glyph('I')->advance_x == 3 );
+}
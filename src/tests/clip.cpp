@@ -0,0 +1,65 @@
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+#include <random>
+#include "vectorfont/clip.h"
+
+TEST_CASE( "Segment clipping", "[clip]")
+{
+	const vectorfont::Viewport viewport(0.0f,0.0f,101.0f,51.0f);
+
+	SECTION( "Clipping and compaction" )
+	{
+		std::vector<float> x0{ 10, -10, 200,  50, 50,  -5, 20}, y0{10, 25,  10, -20, 25, 60, 20};
+		std::vector<float> x1{ 20, 110, 300,  50, 50, -20, 20}, y1{20, 25,  20,  80, 25, 70, 20};
+		std::vector<uint8_t> caps{0,1,0,1,0,0,1};
+
+		const auto count = vectorfont::clip_segments(vectorfont::SegmentBuffers<float>{x0,y0,x1,y1,caps},x0.size(),viewport);
+		REQUIRE( count == 5 );
+
+		REQUIRE( x0[0] == 10 ); REQUIRE( y0[0] == 10 ); REQUIRE( x1[0] == 20 ); REQUIRE( y1[0] == 20 );
+		REQUIRE( x0[1] == 0 ); REQUIRE( x1[1] == 100 ); REQUIRE( y1[1] == 25 ); REQUIRE( caps[1] == 1 );
+		REQUIRE( x0[2] == 50 ); REQUIRE( y0[2] == 0 ); REQUIRE( y1[2] == 50 ); REQUIRE( caps[2] == 1 );
+		REQUIRE( x0[3] == 50 ); REQUIRE( y0[3] == 25 ); REQUIRE( caps[3] == 0 );
+		REQUIRE( x0[4] == 20 ); REQUIRE( y1[4] == 20 ); REQUIRE( caps[4] == 1 );
+	}
+
+	SECTION( "Batches match the scalar clipper" )
+	{
+		std::mt19937 random(1234);
+		std::uniform_real_distribution<float> coord(-50.0f,150.0f);
+
+		const size_t count = 1003;
+		std::vector<float> x0(count), y0(count), x1(count), y1(count);
+		std::vector<uint8_t> caps(count);
+		for(size_t i = 0; i < count; ++i)
+		{
+			x0[i] = coord(random); y0[i] = coord(random);
+			x1[i] = (i % 7) ? coord(random) : x0[i];
+			y1[i] = (i % 5) ? coord(random) : y0[i];
+			caps[i] = static_cast<uint8_t>(i & 1);
+		}
+
+		std::vector<float> ex0, ey0, ex1, ey1;
+		std::vector<uint8_t> ecaps;
+		for(size_t i = 0; i < count; ++i)
+		{
+			float sx0 = x0[i], sy0 = y0[i], sx1 = x1[i], sy1 = y1[i];
+			if(vectorfont::detail::clip_segment(viewport,sx0,sy0,sx1,sy1))
+			{
+				ex0.push_back(sx0); ey0.push_back(sy0); ex1.push_back(sx1); ey1.push_back(sy1);
+				ecaps.push_back(caps[i]);
+			}
+		}
+
+		const auto clipped = vectorfont::clip_segments(vectorfont::SegmentBuffers<float>{x0,y0,x1,y1,caps},count,viewport);
+		REQUIRE( clipped == ex0.size() );
+		REQUIRE( clipped > 0 );
+		REQUIRE( clipped < count );
+		x0.resize(clipped); y0.resize(clipped); x1.resize(clipped); y1.resize(clipped); caps.resize(clipped);
+		REQUIRE( x0 == ex0 );
+		REQUIRE( y0 == ey0 );
+		REQUIRE( x1 == ex1 );
+		REQUIRE( y1 == ey1 );
+		REQUIRE( caps == ecaps );
+	}
+}
@@ -0,0 +1,79 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+#include <memory_resource>
+#include "vectorfont/compressed.h"
+#include "vectorfont/hershey.h"
+#include "vectorfont/builder.h"
+#include "test_font.h"
+#include "hershey_font.h"
+
+template<typename F>
+static std::vector<int> collect(const F & font, const std::u32string & text)
+{
+	std::vector<int> output;
+	font.execute(text,[&](vectorfont::Primitive primitive, std::span<const typename F::coord_type> args)->bool
+		{
+			output.push_back(primitive.command);
+			output.push_back(primitive.cap);
+			output.insert(output.end(),args.begin(),args.end());
+			return false;
+		});
+	return output;
+}
+
+TEST_CASE( "Compressed font", "[compressed]")
+{
+	auto p_font = vectorfont::parse_hershey_font(test_font_svg);
+	REQUIRE( p_font != nullptr );
+
+	vectorfont::FontBuilder builder(*p_font);
+	builder.start_glyph('x',20);
+	builder.moveto(-300,300);
+	builder.lineto(-299,-2000,vectorfont::cap::SQUARE);
+	builder.lineto(3000,0);
+	builder.lineto(3001,1,3);
+	builder.lineto(3002,2,2);
+	p_font = builder.build();
+
+	const vectorfont::CompressedFont compressed(*p_font);
+
+	SECTION( "Decodes to the same primitives" )
+	{
+		const std::u32string text = U"AI-x?一 A";
+		REQUIRE( collect(compressed,text) == collect(*p_font,text) );
+		REQUIRE( (compressed.string_rect(text) == p_font->string_rect(text)) );
+		REQUIRE( compressed.glyph_count() == p_font->glyph_count() );
+
+		const auto index = compressed.glyph_index('x');
+		REQUIRE( compressed.glyph_advance(index) == 20 );
+		REQUIRE( (compressed.glyph_rect(index) == vectorfont::Rectangle<int32_t>(p_font->glyph_rects()[index])) );
+	}
+
+	SECTION( "Storage is allocated from the memory resource" )
+	{
+		std::pmr::monotonic_buffer_resource arena;
+		const vectorfont::CompressedFont arena_font(*p_font,&arena);
+		REQUIRE( arena_font.get_allocator().resource() == &arena );
+		REQUIRE( arena_font.code_index().get_allocator().resource() == &arena );
+		REQUIRE( collect(arena_font,U"AI") == collect(*p_font,U"AI") );
+	}
+}
+
+TEST_CASE( "Compressed Hershey glyphs are a third of the size", "[compressed]")
+{
+	auto p_font = vectorfont::parse_hershey_font(hershey_font_svg);
+	REQUIRE( p_font != nullptr );
+	const vectorfont::CompressedFont compressed(*p_font);
+
+	const std::u32string text = U"ACHIOSeo08";
+	REQUIRE( collect(compressed,text) == collect(*p_font,text) );
+
+	// The glyph records, geometry and offsets, the code index is the same 
+	// size in both.
+	const auto plain 	= p_font->memory_usage();
+	const auto small 	= compressed.memory_usage();
+	const auto plain_size = plain.glyphs + plain.primitives + plain.parameters;
+	const auto small_size = small.glyphs + small.primitives;
+	REQUIRE( small_size * 3 <= plain_size );
+}
@@ -0,0 +1,61 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+#include "vectorfont/cull.h"
+#include "vectorfont/hershey.h"
+#include "test_font.h"
+
+TEST_CASE( "Viewport culling", "[cull]")
+{
+	auto p_font = vectorfont::parse_hershey_font(test_font_svg);
+	REQUIRE( p_font != nullptr );
+
+	const vectorfont::Viewport viewport(0.0f,0.0f,41.0f,41.0f);
+	const std::string text(100,'I');
+
+	std::vector<float> lines;
+	auto record_lines = [&](vectorfont::Primitive primitive, std::span<const float> args)
+	{
+		if(primitive.command == vectorfont::command::LINETO)
+			lines.push_back(args[0]);
+		return false;
+	};
+
+	SECTION( "Execution stops once the pen passes the viewport" )
+	{
+		const auto affine = vectorfont::Affine::font_scale(32,p_font->units_per_em(),0,30);
+		REQUIRE( vectorfont::execute_culled(*p_font,text,affine,viewport,record_lines) == 7 );
+		REQUIRE( lines == std::vector<float>{3,9,15,21,27,33,39} );
+	}
+
+	SECTION( "Glyphs before the viewport are skipped" )
+	{
+		const auto affine = vectorfont::Affine::font_scale(32,p_font->units_per_em(),-20,30);
+		REQUIRE( vectorfont::execute_culled(*p_font,text,affine,viewport,record_lines) == 11 );
+		REQUIRE( lines == std::vector<float>{1,7,13,19,25,31,37,43} );
+	}
+
+	SECTION( "Glyphs above or below the viewport are skipped" )
+	{
+		const auto affine = vectorfont::Affine::font_scale(32,p_font->units_per_em(),0,-5);
+		REQUIRE( vectorfont::execute_culled(*p_font,text,affine,viewport,record_lines) == 7 );
+		REQUIRE( lines.empty() );
+	}
+
+	SECTION( "Culled layout" )
+	{
+		const auto affine = vectorfont::Affine::font_scale(32,p_font->units_per_em(),-20,30);
+		std::vector<float> x0(10), y0(10), x1(10), y1(10);
+		const auto size = vectorfont::layout_segments_culled(*p_font,text,vectorfont::SegmentBuffers<float>{x0,y0,x1,y1},affine,viewport);
+		REQUIRE( size.codes == 11 );
+		REQUIRE( size.segments == 8 );
+		REQUIRE( x0[0] == 1 );
+		REQUIRE( y0[0] == 30 );
+		REQUIRE( y1[0] == 10 );
+		REQUIRE( x1[7] == 43 );
+
+		const auto partial = vectorfont::layout_segments_culled(*p_font,text,vectorfont::SegmentBuffers<float>{std::span(x0).first(2),y0,x1,y1},affine,viewport);
+		REQUIRE( partial.segments == 2 );
+		REQUIRE( partial.codes == 5 );
+	}
+}
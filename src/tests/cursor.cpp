@@ -0,0 +1,73 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include "vectorfont/cursor.h"
+#include "vectorfont/hershey.h"
+#include "test_font.h"
+
+TEST_CASE( "Render cursor", "[cursor]")
+{
+	std::shared_ptr<const vectorfont::Font> p_font = vectorfont::parse_hershey_font(test_font_svg);
+	REQUIRE( p_font != nullptr );
+
+	auto record = [](std::vector<int> & out)
+	{
+		return [&out](vectorfont::Primitive primitive, std::span<const int16_t> args)
+		{
+			out.push_back(primitive.command);
+			out.insert(out.end(),args.begin(),args.end());
+			return false;
+		};
+	};
+
+	const std::string text("A?I- A");
+	std::vector<int> expected;
+	p_font->execute(text,record(expected));
+
+	SECTION( "Stepping a number of primitives at a time" )
+	{
+		vectorfont::RenderCursor cursor(p_font,text);
+		std::vector<int> output;
+		size_t steps = 0;
+		while(!cursor.done())
+		{
+			REQUIRE( cursor.step(3,record(output)) <= 3 );
+			++steps;
+		}
+		REQUIRE( output == expected );
+		REQUIRE( steps == 7 );
+		REQUIRE( cursor.step(3,record(output)) == 0 );
+	}
+
+	SECTION( "A callback returning true suspends the cursor" )
+	{
+		vectorfont::RenderCursor cursor(p_font,text);
+		std::vector<int> output;
+		auto stop_after_lineto = [&](vectorfont::Primitive primitive, std::span<const int16_t> args)
+		{
+			record(output)(primitive,args);
+			return primitive.command == vectorfont::command::LINETO;
+		};
+
+		REQUIRE( cursor.step(100,stop_after_lineto) == 2 );
+		REQUIRE( cursor.position() == 0 );
+		while(cursor.step(100,stop_after_lineto) > 0) {}
+		REQUIRE( output == expected );
+	}
+
+	SECTION( "Time budget" )
+	{
+		vectorfont::RenderCursor cursor(p_font,text);
+		std::vector<int> output;
+		cursor.step_for(std::chrono::seconds(10),record(output));
+		REQUIRE( cursor.done() );
+		REQUIRE( output == expected );
+
+		cursor.reset();
+		output.clear();
+		REQUIRE( cursor.step_for(std::chrono::nanoseconds(0),record(output)) == vectorfont::RenderCursor::CLOCK_INTERVAL );
+		REQUIRE_FALSE( cursor.done() );
+	}
+}
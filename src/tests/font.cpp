@@ -0,0 +1,240 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include "vectorfont/vectorfont.h"
+#include "vectorfont/hershey.h"
+#include "vectorfont/builder.h"
+#include "test_font.h"
+#include "hershey_font.h"
+
+TEST_CASE( "Glyph lookup", "[font-lookup]")
+{
+	auto p_font = vectorfont::parse_hershey_font(test_font_svg);
+	REQUIRE( p_font != nullptr );
+
+	SECTION( "Loaded glyphs are found through the lookup table" )
+	{
+		REQUIRE( p_font->code_index().lookup.size() == vectorfont::GlyphIndex::LOOKUP_SIZE );
+		for(uint32_t code : std::u32string(U"AI-"))
+		{
+			auto p_glyph = p_font->get_glyph(code);
+			REQUIRE( p_glyph.has_value() );
+			REQUIRE( p_glyph->code == code );
+		}
+		REQUIRE( p_font->get_glyph('I')->primitive_count == 2 );
+	}
+
+	SECTION( "UTF-8 encoded codes are found through the sparse table" )
+	{
+		REQUIRE( p_font->code_index().sparse_codes.size() == 1 );
+		auto p_glyph = p_font->get_glyph(0x4E00);
+		REQUIRE( p_glyph.has_value() );
+		REQUIRE( p_glyph->advance_x == 32 );
+	}
+
+	SECTION( "Missing glyphs" )
+	{
+		REQUIRE_FALSE( p_font->get_glyph('Z') );
+		REQUIRE_FALSE( p_font->get_glyph(0x4E01) );
+		REQUIRE_FALSE( p_font->get_glyph(0xFFFFFFFF) );
+	}
+
+	SECTION( "Glyphs added by rebuilding the font are indexed" )
+	{
+		vectorfont::FontBuilder builder(*p_font);
+		builder.start_glyph(0x1F600,32);
+		builder.moveto(0,0);
+		p_font = builder.build();
+		REQUIRE( p_font->get_glyph('A') );
+		REQUIRE( p_font->get_glyph(0x1F600)->code == 0x1F600 );
+		REQUIRE( p_font->get_glyph(0x4E00)->code == 0x4E00 );
+	}
+}
+
+TEST_CASE( "Glyph index selection", "[font-index]")
+{
+	vectorfont::FontBuilder builder;
+
+	SECTION( "Densely populated ranges use a single lookup table" )
+	{
+		for(uint32_t code = 0x400; code < 0x500; code += 2)
+			builder.start_glyph(code,10);
+		const auto p_font = builder.build();
+		const auto & font = *p_font;
+
+		REQUIRE( font.code_index().lookup_base == 0x400 );
+		REQUIRE( font.code_index().sparse_codes.empty() );
+		REQUIRE( font.glyph_index(0x402) == 1 );
+		REQUIRE( font.glyph_index(0x403) == vectorfont::Font::NO_GLYPH );
+		REQUIRE( font.glyph_index('A') == vectorfont::Font::NO_GLYPH );
+	}
+
+	SECTION( "Sparse codes are binary searched" )
+	{
+		for(uint32_t code = 0; code < 1000; ++code)
+			builder.start_glyph(0x10000 + code * 37,10);
+		builder.start_glyph('A',10);
+		const auto p_font = builder.build();
+		const auto & font = *p_font;
+
+		REQUIRE( font.code_index().lookup_base == 0 );
+		REQUIRE( font.code_index().sparse_codes.size() == 1000 );
+		REQUIRE( font.glyph_index('A') == 1000 );
+		for(uint32_t code = 0; code < 1000; ++code)
+		{
+			REQUIRE( font.glyph_index(0x10000 + code * 37) == code );
+			REQUIRE( font.glyph_index(0x10001 + code * 37) == vectorfont::Font::NO_GLYPH );
+		}
+		REQUIRE( font.glyph_index(0xFFFF) == vectorfont::Font::NO_GLYPH );
+	}
+}
+
+TEST_CASE( "String measurement", "[font-measure]")
+{
+	auto p_font = vectorfont::parse_hershey_font(test_font_svg);
+	REQUIRE( p_font != nullptr );
+
+	REQUIRE( p_font->string_rect(std::string("AI")).right == 18 + 3 );
+
+	int advance = 0;
+	p_font->execute(std::string("A?I"),[&](vectorfont::Primitive primitive, std::span<const int16_t> args)->bool
+		{
+			if(primitive.command == vectorfont::command::ADVANCE)
+				advance += args[0];
+			return false;
+		});
+	REQUIRE( advance == 18 + 8 + 6 );
+}
+
+namespace
+{
+struct RecordingVisitor
+{
+	std::vector<int> output;
+
+	void moveto(int16_t x, int16_t y)								{output.insert(output.end(),{vectorfont::command::MOVETO,x,y});}
+	void lineto(int16_t x, int16_t y, int linecap)	{output.insert(output.end(),{vectorfont::command::LINETO,x,y,linecap});}
+	void advance(int16_t advance_x)									{output.insert(output.end(),{vectorfont::command::ADVANCE,advance_x});}
+};
+}
+
+TEST_CASE( "Callbacks and visitors", "[font-visit]")
+{
+	auto p_font = vectorfont::parse_hershey_font(test_font_svg);
+	REQUIRE( p_font != nullptr );
+
+	const std::string text("-A?I");
+	std::vector<int> expected;
+	p_font->execute(text,[&](vectorfont::Primitive primitive, std::span<const int16_t> args)
+		{
+			expected.push_back(primitive.command);
+			expected.insert(expected.end(),args.begin(),args.end());
+			if(primitive.command == vectorfont::command::LINETO)
+				expected.push_back(primitive.cap);
+			return false;
+		});
+
+	RecordingVisitor visitor;
+	p_font->visit(text,visitor);
+	REQUIRE( visitor.output == expected );
+
+	int advance = 0;
+	const vectorfont::Font::callback_type callback = [&](vectorfont::Primitive primitive, std::span<const int16_t> args)
+		{
+			if(primitive.command == vectorfont::command::ADVANCE)
+				advance += args[0];
+			return false;
+		};
+	p_font->execute(uint32_t{'A'},callback);
+	p_font->execute(text,callback);
+	REQUIRE( advance == 18 + 12 + 18 + 8 + 6 );
+}
+
+TEST_CASE( "Coordinate types", "[font-types]")
+{
+	auto p_font16 	= vectorfont::parse_hershey_font(test_font_svg);
+	auto p_font8 		= vectorfont::parse_hershey_font<int8_t>(test_font_svg);
+	auto p_fontf 		= vectorfont::parse_hershey_font<float>(test_font_svg);
+	REQUIRE( p_font16 != nullptr );
+	REQUIRE( p_font8 != nullptr );
+	REQUIRE( p_fontf != nullptr );
+
+	REQUIRE( p_font8->parameters().size() == p_font16->parameters().size() );
+	REQUIRE( std::equal(p_font8->parameters().begin(),p_font8->parameters().end(),p_font16->parameters().begin()) );
+	REQUIRE( std::equal(p_fontf->parameters().begin(),p_fontf->parameters().end(),p_font16->parameters().begin()) );
+
+	SECTION( "String measurement does not overflow the coordinate type" )
+	{
+		const std::string text(20,'A');
+		REQUIRE( p_font8->string_rect(text).right == 19 * 18 + 17 );
+		REQUIRE( p_fontf->string_rect(text).right == 19.0f * 18.0f + 17.0f );
+	}
+
+	SECTION( "Fonts that do not fit the coordinate type fail to load" )
+	{
+		std::string svg = test_font_svg;
+		svg.replace(svg.find("L 17 0"),6,"L 170 0");
+		REQUIRE( vectorfont::parse_hershey_font<int8_t>(svg) == nullptr );
+		REQUIRE( vectorfont::parse_hershey_font(svg) != nullptr );
+	}
+
+	SECTION( "Paths are only parsed once" )
+	{
+		std::string svg = test_font_svg;
+		svg.replace(svg.find("L 17 0"),6,"L 17 x");
+
+		std::ostringstream errors;
+		auto p_previous = std::cerr.rdbuf(errors.rdbuf());
+		auto p_font = vectorfont::parse_hershey_font(svg);
+		std::cerr.rdbuf(p_previous);
+
+		REQUIRE( p_font != nullptr );
+		REQUIRE( errors.str() == "Failed to parse argument 'x'\n" );
+	}
+}
+
+TEST_CASE( "Hershey fonts in int8_t", "[font-types]")
+{
+	SECTION( "Hershey glyphs in their original grid fit" )
+	{
+		auto p_font16 	= vectorfont::parse_hershey_font(hershey_font_svg);
+		auto p_font8 		= vectorfont::parse_hershey_font<int8_t>(hershey_font_svg);
+		REQUIRE( p_font8 != nullptr );
+		REQUIRE( p_font8->glyph_count() == 10 );
+		REQUIRE( std::equal(p_font8->parameters().begin(),p_font8->parameters().end(),p_font16->parameters().begin(),p_font16->parameters().end()) );
+		REQUIRE( p_font8->memory_usage().parameters * 2 == p_font16->memory_usage().parameters );
+	}
+
+	SECTION( "Fonts with more units per em can be rescaled" )
+	{
+		const std::string svg = R"(<?xml version="1.0" standalone="no"?>
+<svg xmlns="http://www.w3.org/2000/svg">
+<defs>
+<font id="simplex-1000" horiz-adv-x="500">
+<font-face units-per-em="1000" ascent="800" descent="-200"/>
+<missing-glyph horiz-adv-x="500"/>
+<glyph unicode="H" horiz-adv-x="688" d="M 125 656 L 125 0 M 562 656 L 562 0 M 125 344 L 562 344"/>
+</font>
+</defs>
+</svg>
+)";
+		REQUIRE( vectorfont::parse_hershey_font<int8_t>(svg) == nullptr );
+
+		auto p_font = vectorfont::parse_hershey_font_scaled<int8_t>(svg,32);
+		REQUIRE( p_font != nullptr );
+		REQUIRE( p_font->units_per_em() == 32 );
+		REQUIRE( p_font->ascent() == 26 );
+		REQUIRE( p_font->descent() == -6 );
+		REQUIRE( p_font->missing_adv_x() == 16 );
+
+		auto p_native = vectorfont::parse_hershey_font(hershey_font_svg);
+		const auto scaled = p_font->get_glyph('H');
+		const auto native = p_native->get_glyph('H');
+		REQUIRE( scaled->advance_x == native->advance_x );
+
+		const auto parameters = p_native->parameters().subspan(native->parameter_index,p_font->parameters().size());
+		REQUIRE( std::equal(p_font->parameters().begin(),p_font->parameters().end(),parameters.begin(),parameters.end()) );
+	}
+}
@@ -0,0 +1,30 @@
+//=============================================================================
+//	Some of the glyphs of the Hershey simplex font, with its strokes and
+//	coordinates, used by the tests that need realistic glyphs.
+//=============================================================================
+#ifndef GUARD_ADE_VECTORFONT_HERSHEY_FONT_H
+#define GUARD_ADE_VECTORFONT_HERSHEY_FONT_H
+
+static constexpr const char * hershey_font_svg =
+R"(<?xml version="1.0" standalone="no"?>
+<svg xmlns="http://www.w3.org/2000/svg">
+<defs>
+<font id="simplex" horiz-adv-x="16">
+<font-face units-per-em="32" ascent="25" descent="-7"/>
+<missing-glyph horiz-adv-x="16"/>
+<glyph unicode="A" horiz-adv-x="18" d="M 5 21 L 1 0 M 5 21 L 9 0 M 2 7 L 8 7"/>
+<glyph unicode="C" horiz-adv-x="21" d="M 18 16 L 17 18 L 15 20 L 13 21 L 9 21 L 7 20 L 5 18 L 4 16 L 3 13 L 3 8 L 4 5 L 5 3 L 7 1 L 9 0 L 13 0 L 15 1 L 17 3 L 18 5"/>
+<glyph unicode="H" horiz-adv-x="22" d="M 4 21 L 4 0 M 18 21 L 18 0 M 4 11 L 18 11"/>
+<glyph unicode="I" horiz-adv-x="8" d="M 4 21 L 4 0"/>
+<glyph unicode="O" horiz-adv-x="22" d="M 9 21 L 7 20 L 5 18 L 4 16 L 3 13 L 3 8 L 4 5 L 5 3 L 7 1 L 9 0 L 13 0 L 15 1 L 17 3 L 18 5 L 19 8 L 19 13 L 18 16 L 17 18 L 15 20 L 13 21 L 9 21"/>
+<glyph unicode="S" horiz-adv-x="20" d="M 17 18 L 15 20 L 12 21 L 8 21 L 5 20 L 3 18 L 3 16 L 4 14 L 5 13 L 7 12 L 13 10 L 15 9 L 16 8 L 17 6 L 17 3 L 15 1 L 12 0 L 8 0 L 5 1 L 3 3"/>
+<glyph unicode="e" horiz-adv-x="17" d="M 3 8 L 15 8 L 15 10 L 14 12 L 13 13 L 11 14 L 8 14 L 6 13 L 4 11 L 3 8 L 3 6 L 4 3 L 6 1 L 8 0 L 11 0 L 13 1 L 15 3"/>
+<glyph unicode="o" horiz-adv-x="19" d="M 8 14 L 6 13 L 4 11 L 3 8 L 3 6 L 4 3 L 6 1 L 8 0 L 11 0 L 13 1 L 15 3 L 16 6 L 16 8 L 15 11 L 13 13 L 11 14 L 8 14"/>
+<glyph unicode="0" horiz-adv-x="20" d="M 9 21 L 6 20 L 4 17 L 3 12 L 3 9 L 4 4 L 6 1 L 9 0 L 11 0 L 14 1 L 16 4 L 17 9 L 17 12 L 16 17 L 14 20 L 11 21 L 9 21"/>
+<glyph unicode="8" horiz-adv-x="20" d="M 8 21 L 5 20 L 4 18 L 4 16 L 5 14 L 7 13 L 11 12 L 14 11 L 16 9 L 17 7 L 17 4 L 16 2 L 15 1 L 12 0 L 8 0 L 5 1 L 4 2 L 3 4 L 3 7 L 4 9 L 6 11 L 9 12 L 13 13 L 15 14 L 16 16 L 16 18 L 15 20 L 12 21 L 8 21"/>
+</font>
+</defs>
+</svg>
+)";
+
+#endif // ! defined GUARD_ADE_VECTORFONT_HERSHEY_FONT_H
@@ -0,0 +1,100 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+#include "vectorfont/layout.h"
+#include "vectorfont/hershey.h"
+#include "test_font.h"
+
+TEST_CASE( "Segment layout", "[layout-segments]")
+{
+	auto p_font = vectorfont::parse_hershey_font(test_font_svg);
+	REQUIRE( p_font != nullptr );
+
+	const std::string text("A?I");
+	const auto size = vectorfont::layout_size(*p_font,text);
+	REQUIRE( size.codes == 3 );
+	REQUIRE( size.segments == 4 );
+	REQUIRE( size.vertices == 7 );
+	REQUIRE( size.runs == 3 );
+
+	std::vector<float> x0(size.segments), y0(size.segments), x1(size.segments), y1(size.segments);
+	std::vector<uint8_t> caps(size.segments);
+	const auto written = vectorfont::layout_segments(*p_font,text,vectorfont::SegmentBuffers<float>{x0,y0,x1,y1,caps},100,50);
+	REQUIRE( written.codes == 3 );
+	REQUIRE( written.segments == 4 );
+	REQUIRE( x0[0] == 101 ); REQUIRE( y0[0] == 50 ); REQUIRE( x1[0] == 109 ); REQUIRE( y1[0] == 70 );
+	REQUIRE( x0[2] == 104 ); REQUIRE( y0[2] == 58 ); REQUIRE( x1[2] == 114 ); REQUIRE( y1[2] == 58 );
+	REQUIRE( x0[3] == 100 + 18 + 8 + 3 ); REQUIRE( y1[3] == 70 );
+	REQUIRE( caps[3] == vectorfont::cap::ROUND );
+
+	SECTION( "Only whole glyphs are written when the buffers are too small" )
+	{
+		const auto partial = vectorfont::layout_segments(*p_font,text,vectorfont::SegmentBuffers<float>{std::span(x0).first(3),y0,x1,y1,{}});
+		REQUIRE( partial.codes == 2 );
+		REQUIRE( partial.segments == 3 );
+	}
+
+	SECTION( "Glyphs are counted exactly at the end of the buffers" )
+	{
+		const std::string long_text("AIAIA");
+		const auto long_size = vectorfont::layout_size(*p_font,long_text);
+		REQUIRE( long_size.segments == 11 );
+
+		std::vector<float> lx0(long_size.segments), ly0(long_size.segments), lx1(long_size.segments), ly1(long_size.segments);
+		const auto long_written = vectorfont::layout_segments(*p_font,long_text,vectorfont::SegmentBuffers<float>{lx0,ly0,lx1,ly1,{}});
+		REQUIRE( long_written.codes == 5 );
+		REQUIRE( long_written.segments == 11 );
+		REQUIRE( lx0[10] == 18 + 6 + 18 + 6 + 4 );
+	}
+}
+
+TEST_CASE( "Polyline layout", "[layout-polylines]")
+{
+	auto p_font = vectorfont::parse_hershey_font(test_font_svg);
+	REQUIRE( p_font != nullptr );
+
+	const std::string text("AI");
+	const auto size = vectorfont::layout_size(*p_font,text);
+
+	std::vector<int32_t> x(size.vertices), y(size.vertices);
+	std::vector<uint32_t> offsets(size.runs + 1);
+	const auto written = vectorfont::layout_polylines(*p_font,text,vectorfont::PolylineBuffers<int32_t>{x,y,offsets});
+	REQUIRE( written.codes == 2 );
+	REQUIRE( written.vertices == 7 );
+	REQUIRE( written.runs == 3 );
+	REQUIRE( offsets == std::vector<uint32_t>{0,3,5,7} );
+	REQUIRE( x == std::vector<int32_t>{1,9,17,4,14,21,21} );
+	REQUIRE( y == std::vector<int32_t>{0,20,0,8,8,0,20} );
+
+	const auto partial = vectorfont::layout_polylines(*p_font,text,vectorfont::PolylineBuffers<int32_t>{x,y,std::span(offsets).first(3)});
+	REQUIRE( partial.codes == 1 );
+	REQUIRE( partial.runs == 2 );
+}
+
+TEST_CASE( "Instanced layout", "[layout-instances]")
+{
+	auto p_font = vectorfont::parse_hershey_font(test_font_svg);
+	REQUIRE( p_font != nullptr );
+
+	const std::string text("A?I-");
+	const auto size = vectorfont::layout_size(*p_font,text);
+	REQUIRE( size.instances == 3 );
+
+	std::vector<vectorfont::GlyphInstance> instances(size.instances);
+	const auto written = vectorfont::layout_instances(*p_font,text,instances,100,50,2);
+	REQUIRE( written.codes == 4 );
+	REQUIRE( written.instances == 3 );
+	REQUIRE( instances[0].glyph_index == p_font->glyph_index('A') );
+	REQUIRE( instances[1].glyph_index == p_font->glyph_index('I') );
+	REQUIRE( instances[1].x == 100 + (18 + 8) * 2 );
+	REQUIRE( instances[2].x == 100 + (18 + 8 + 6) * 2 );
+	REQUIRE( instances[2].y == 50 );
+	REQUIRE( instances[2].scale == 2 );
+
+	const auto geometry = p_font->geometry();
+	REQUIRE( geometry.glyph_ranges[instances[1].glyph_index].primitive_count == 2 );
+
+	const auto partial = vectorfont::layout_instances(*p_font,text,std::span(instances).first(1));
+	REQUIRE( partial.codes == 2 );
+	REQUIRE( partial.instances == 1 );
+}
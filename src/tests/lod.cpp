@@ -0,0 +1,106 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+#include <array>
+#include "vectorfont/lod.h"
+#include "vectorfont/builder.h"
+#include "vectorfont/hershey.h"
+#include "test_font.h"
+
+namespace
+{
+std::vector<int> collect_lod(const vectorfont::Font & font, const std::string & text, float pixel_size)
+{
+	std::vector<int> output;
+	vectorfont::execute_lod(font,text,pixel_size,[&](vectorfont::Primitive primitive, std::span<const int16_t> args)
+		{
+			output.push_back(primitive.command);
+			output.insert(output.end(),args.begin(),args.end());
+			return false;
+		});
+	return output;
+}
+}
+
+TEST_CASE( "Levels of detail", "[lod]")
+{
+	using namespace vectorfont::command;
+
+	vectorfont::FontBuilder builder;
+	builder.set_metrics(24,-8,32);
+	builder.start_glyph('w',20);
+	builder.moveto(0,0);
+	builder.lineto(4,1);				// within 1 unit of the straight line
+	builder.lineto(8,0);
+	builder.lineto(12,6);				// a real corner
+	builder.lineto(16,0,vectorfont::cap::SQUARE);
+	builder.start_glyph('v',20);	// shares the geometry of 'w'
+	builder.moveto(0,0);
+	builder.lineto(4,1);
+	builder.lineto(8,0);
+	builder.lineto(12,6);
+	builder.lineto(16,0,vectorfont::cap::SQUARE);
+	builder.deduplicate();
+
+	const std::array<float,3> tolerances{10.0f,2.0f,-1.0f};
+	builder.set_lod_tolerances(tolerances);
+	const auto p_font = builder.build();
+
+	REQUIRE( p_font->lod_count() == 3 );
+	REQUIRE( p_font->lod_tolerance(0) == 0.0f );
+	REQUIRE( p_font->lod_tolerance(1) == 2.0f );
+	REQUIRE( p_font->lod_tolerance(2) == 10.0f );
+
+	const auto level1 = p_font->geometry(1);
+	REQUIRE( level1.glyph_ranges[0].primitive_count == 4 );
+	REQUIRE( level1.glyph_ranges[1].primitive_index == level1.glyph_ranges[0].primitive_index );
+	REQUIRE( p_font->geometry(2).glyph_ranges[0].primitive_count == 2 );
+	REQUIRE( p_font->geometry(5).glyph_ranges[0].primitive_count == 2 );
+	REQUIRE( p_font->lod_tolerance(5) == 10.0f );
+
+	SECTION( "Selecting a level" )
+	{
+		REQUIRE( vectorfont::select_lod(*p_font,64) == 0 );
+		REQUIRE( vectorfont::select_lod(*p_font,8) == 1 );
+		REQUIRE( vectorfont::select_lod(*p_font,1) == 2 );
+		REQUIRE( vectorfont::select_lod(*p_font,1,{0.01f,0.0f}) == 0 );
+	}
+
+	SECTION( "Executing a level" )
+	{
+		REQUIRE( collect_lod(*p_font,"w",64) == std::vector<int>{MOVETO,0,0,LINETO,4,1,LINETO,8,0,LINETO,12,6,LINETO,16,0,ADVANCE,20} );
+		REQUIRE( collect_lod(*p_font,"w",8) == std::vector<int>{MOVETO,0,0,LINETO,8,0,LINETO,12,6,LINETO,16,0,ADVANCE,20} );
+		REQUIRE( p_font->geometry(1).primitives.back().cap == vectorfont::cap::SQUARE );
+	}
+
+	SECTION( "Greeking" )
+	{
+		REQUIRE( collect_lod(*p_font,"w?",2) == std::vector<int>{MOVETO,0,3,LINETO,16,3,ADVANCE,20,ADVANCE,0} );
+	}
+
+	SECTION( "Levels are rebuilt by a builder copy" )
+	{
+		vectorfont::FontBuilder copy(*p_font);
+		const auto p_copy = copy.build();
+		REQUIRE( p_copy->lod_count() == 3 );
+		REQUIRE( p_copy->geometry(2).parameters.size() == p_font->geometry(2).parameters.size() );
+	}
+}
+
+TEST_CASE( "Loaded fonts have no levels of detail", "[lod-default]")
+{
+	auto p_font = vectorfont::parse_hershey_font(test_font_svg);
+	REQUIRE( p_font != nullptr );
+	REQUIRE( p_font->lod_count() == 1 );
+	REQUIRE( vectorfont::select_lod(*p_font,1) == 0 );
+
+	SECTION( "Levels beyond the last level use the last level" )
+	{
+		const auto index = p_font->glyph_index('A');
+		size_t count = 0;
+		p_font->execute_glyph(index,[&](vectorfont::Primitive,std::span<const int16_t>){++count; return false;},3);
+		REQUIRE( count == 6 );
+		REQUIRE( p_font->geometry(3).glyph_ranges.size() == p_font->glyph_count() );
+		REQUIRE( p_font->lod_tolerance(3) == 0.0f );
+	}
+}
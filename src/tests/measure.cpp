@@ -0,0 +1,49 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include "vectorfont/measure.h"
+#include "vectorfont/hershey.h"
+#include "test_font.h"
+
+TEST_CASE( "String measurement", "[measure]")
+{
+	auto p_font = vectorfont::parse_hershey_font(test_font_svg);
+	REQUIRE( p_font != nullptr );
+	REQUIRE( vectorfont::measure_width(*p_font,std::string()) == 0 );
+	REQUIRE( vectorfont::measure_width(*p_font,std::string("A?I")) == 18 + 8 + 6 );
+	REQUIRE( vectorfont::measure_width(*p_font,std::u32string(U"A一")) == 18 + 32 );
+
+	std::string text;
+	for(size_t i = 0; i < 200; ++i)
+		text += "AI-? "[i % 5];
+
+	const auto bounds = vectorfont::measure_bounds(*p_font,text);
+	const auto rect = p_font->string_rect(text);
+	REQUIRE( bounds.left == rect.left );
+	REQUIRE( bounds.top == rect.top );
+	REQUIRE( bounds.right == rect.right );
+	REQUIRE( bounds.bottom == rect.bottom );
+	REQUIRE( vectorfont::measure_width(*p_font,text) == 40 * (18 + 6 + 12 + 8 + 8) );
+
+	SECTION( "Widths of long strings match the glyph advances" )
+	{
+		std::u32string long_text;
+		int32_t expected = 0;
+		for(size_t i = 0; i < 150; ++i)
+		{
+			const char32_t code = U"一A?I-一"[i % 6];
+			long_text += code;
+			const auto index = p_font->glyph_index(code);
+			expected += (index != vectorfont::Font::NO_GLYPH) ? p_font->glyph_advances()[index] : p_font->missing_adv_x();
+		}
+
+		REQUIRE( vectorfont::measure_width(*p_font,long_text) == expected );
+		REQUIRE( vectorfont::measure_width(*vectorfont::parse_hershey_font<int8_t>(test_font_svg),long_text) == expected );
+		REQUIRE( vectorfont::measure_width(*vectorfont::parse_hershey_font<float>(test_font_svg),long_text) == static_cast<float>(expected) );
+		REQUIRE( vectorfont::measure_bounds(*p_font,long_text).right == p_font->string_rect(long_text).right );
+	}
+
+	const auto small = vectorfont::measure_bounds(*p_font,std::string("I"));
+	REQUIRE( small.left == 0 );
+	REQUIRE( small.right == 3 );
+	REQUIRE( small.bottom == 20 );
+}
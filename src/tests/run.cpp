@@ -0,0 +1,52 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+#include <memory>
+#include "vectorfont/run.h"
+#include "vectorfont/hershey.h"
+#include "test_font.h"
+
+TEST_CASE( "Text runs", "[run]")
+{
+	std::shared_ptr<const vectorfont::Font> p_font = vectorfont::parse_hershey_font(test_font_svg);
+	REQUIRE( p_font != nullptr );
+
+	const std::string text("A?I-");
+	const vectorfont::TextRun run(p_font,text);
+	REQUIRE( run.size() == 4 );
+	REQUIRE( run.glyphs()[1] == vectorfont::Font::NO_GLYPH );
+	REQUIRE( run.glyphs()[2] == p_font->glyph_index('I') );
+	REQUIRE( std::vector<int32_t>(run.pen_x().begin(),run.pen_x().end()) == std::vector<int32_t>{0,18,26,32,44} );
+	REQUIRE( run.width() == 44 );
+	REQUIRE( run.rect().right == p_font->string_rect(text).right );
+	REQUIRE( run.rect().bottom == p_font->string_rect(text).bottom );
+
+	std::vector<int> expected, output;
+	auto record = [](std::vector<int> & out)
+	{
+		return [&out](vectorfont::Primitive primitive, std::span<const int16_t> args)
+		{
+			out.push_back(primitive.command);
+			out.insert(out.end(),args.begin(),args.end());
+			return false;
+		};
+	};
+	p_font->execute(text,record(expected));
+	run.execute(record(output));
+	REQUIRE( output == expected );
+
+	REQUIRE( run.hit_test(-5) == 0 );
+	REQUIRE( run.hit_test(17) == 0 );
+	REQUIRE( run.hit_test(18) == 1 );
+	REQUIRE( run.hit_test(30) == 2 );
+	REQUIRE( run.hit_test(44) == 4 );
+
+	const auto copy = run;
+	REQUIRE( copy.glyphs().data() == run.glyphs().data() );
+	REQUIRE( &copy.font() == p_font.get() );
+
+	const vectorfont::TextRun empty;
+	REQUIRE( empty.empty() );
+	REQUIRE( empty.width() == 0 );
+	REQUIRE( empty.hit_test(10) == 0 );
+}
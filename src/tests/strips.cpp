@@ -0,0 +1,77 @@
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+#include "vectorfont/builder.h"
+#include "vectorfont/hershey.h"
+#include "test_font.h"
+
+namespace
+{
+std::vector<std::vector<int>> collect_strips(const vectorfont::Font & font, uint32_t code)
+{
+	std::vector<std::vector<int>> output;
+	const auto & glyph_strips = font.glyph_strips()[font.glyph_index(code)];
+	for(size_t strip = 0; strip < glyph_strips.strip_count; ++strip)
+	{
+		const auto vertices = font.strip(glyph_strips.strip_index + strip);
+		output.emplace_back(vertices.begin(),vertices.end());
+	}
+	return output;
+}
+}
+
+TEST_CASE( "Polyline strips", "[strips]")
+{
+	vectorfont::FontBuilder builder;
+	builder.set_metrics(24,-8,32);
+	builder.set_build_strips();
+	builder.start_glyph('t',24);		// a triangle drawn as three separate lines
+	builder.moveto(0,0);
+	builder.lineto(10,0);
+	builder.moveto(10,0);
+	builder.lineto(5,8);
+	builder.moveto(0,0);					// joined reversed
+	builder.lineto(5,8);
+	builder.moveto(20,0);					// not connected
+	builder.lineto(20,10);
+	builder.start_glyph('p',24);		// joined to the front of the strip
+	builder.moveto(5,5);
+	builder.lineto(10,10);
+	builder.moveto(0,0);
+	builder.lineto(5,5);
+	builder.moveto(15,15);				// a single point is dropped
+	builder.start_glyph('u',24);		// shares the geometry of 'p'
+	builder.moveto(5,5);
+	builder.lineto(10,10);
+	builder.moveto(0,0);
+	builder.lineto(5,5);
+	builder.moveto(15,15);
+	builder.start_glyph(' ',8);
+	builder.deduplicate();
+	const auto p_font = builder.build();
+
+	REQUIRE( p_font->glyph_strips().size() == p_font->glyph_count() );
+	REQUIRE( p_font->strip_offsets().back() * 2 == p_font->strip_vertices().size() );
+
+	REQUIRE( collect_strips(*p_font,'t') == std::vector<std::vector<int>>{{0,0,10,0,5,8,0,0},{20,0,20,10}} );
+	REQUIRE( collect_strips(*p_font,'p') == std::vector<std::vector<int>>{{0,0,5,5,10,10}} );
+	REQUIRE( p_font->glyph_strips()[p_font->glyph_index('u')].strip_index == p_font->glyph_strips()[p_font->glyph_index('p')].strip_index );
+	REQUIRE( collect_strips(*p_font,' ').empty() );
+}
+
+TEST_CASE( "Polyline strips are optional", "[strips-optional]")
+{
+	auto p_loaded = vectorfont::parse_hershey_font(test_font_svg);
+	REQUIRE( p_loaded != nullptr );
+	REQUIRE( p_loaded->glyph_strips().empty() );
+	REQUIRE( p_loaded->memory_usage().strips == 0 );
+
+	vectorfont::FontBuilder builder(*p_loaded);
+	builder.set_build_strips();
+	const auto p_font = builder.build();
+	REQUIRE( p_font->glyph_strips().size() == p_font->glyph_count() );
+	REQUIRE( collect_strips(*p_font,'A') == std::vector<std::vector<int>>{{1,0,9,20,17,0},{4,8,14,8}} );
+	REQUIRE( collect_strips(*p_font,'I') == std::vector<std::vector<int>>{{3,0,3,20}} );
+
+	vectorfont::FontBuilder copy(*p_font);		// keeps the strips of the font it copies
+	REQUIRE( copy.build()->glyph_strips().size() == p_font->glyph_count() );
+}
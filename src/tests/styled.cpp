@@ -0,0 +1,38 @@
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+#include "vectorfont/styled.h"
+#include "vectorfont/hershey.h"
+#include "test_font.h"
+
+TEST_CASE( "Styled runs", "[styled]")
+{
+	auto p_font = vectorfont::parse_hershey_font(test_font_svg);
+	REQUIRE( p_font != nullptr );
+
+	const std::vector<vectorfont::StyledRun> runs{{p_font.get(),1.0f,"A"},{p_font.get(),2.0f,"I"},{nullptr,1.0f,"x"},{p_font.get(),1.0f,"I"}};
+	const auto size = vectorfont::styled_size(runs);
+	REQUIRE( size.size.codes == 3 );
+	REQUIRE( size.size.segments == 5 );
+	REQUIRE( size.styled_runs == 4 );
+	REQUIRE( size.width == 18 + 6 * 2 + 6 );
+	REQUIRE( size.ascent == 48 );
+	REQUIRE( size.descent == -16 );
+
+	std::vector<float> x0(size.size.segments), y0(size.size.segments), x1(size.size.segments), y1(size.size.segments);
+	const vectorfont::SegmentBuffers<float> buffers{x0,y0,x1,y1};
+	const auto layout = vectorfont::layout_styled_segments(runs,buffers,vectorfont::Affine::translation(100,0) * vectorfont::Affine::scaling(1,-1));
+	REQUIRE( layout.size.segments == 5 );
+	REQUIRE( layout.width == size.width );
+	REQUIRE( x0[3] == 100 + 18 + 3 * 2 ); REQUIRE( y0[3] == 0 ); REQUIRE( y1[3] == -40 );
+	REQUIRE( x0[4] == 100 + 30 + 3 ); REQUIRE( y1[4] == -20 );
+
+	SECTION( "Only whole glyphs are written when the buffers are too small" )
+	{
+		const auto partial = vectorfont::layout_styled_segments(runs,vectorfont::SegmentBuffers<float>{std::span(x0).first(4),y0,x1,y1});
+		REQUIRE( partial.size.codes == 2 );
+		REQUIRE( partial.size.segments == 4 );
+		REQUIRE( partial.styled_runs == 3 );
+		REQUIRE( partial.width == 30 );
+		REQUIRE( y1[3] == 40 );
+	}
+}
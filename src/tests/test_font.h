@@ -0,0 +1,24 @@
+//=============================================================================
+//	Small SVG font shared by the unit tests.
+//=============================================================================
+#ifndef GUARD_ADE_VECTORFONT_TEST_FONT_H
+#define GUARD_ADE_VECTORFONT_TEST_FONT_H
+
+static constexpr const char * test_font_svg = 
+R"(<?xml version="1.0" standalone="no"?>
+<svg xmlns="http://www.w3.org/2000/svg">
+<defs>
+<font id="test" horiz-adv-x="10">
+<font-face units-per-em="32" ascent="24" descent="-8"/>
+<missing-glyph horiz-adv-x="8"/>
+<glyph unicode=" " horiz-adv-x="8"/>
+<glyph unicode="A" horiz-adv-x="18" d="M 1 0 L 9 20 L 17 0 M 4 8 L 14 8"/>
+<glyph unicode="I" horiz-adv-x="6" d="M 3 0 L 3 20"/>
+<glyph unicode="-" horiz-adv-x="12" d="M 2 10 l 8 0"/>
+<glyph unicode="一" horiz-adv-x="32" d="M 2 12 L 30 12"/>
+</font>
+</defs>
+</svg>
+)";
+
+#endif // ! defined GUARD_ADE_VECTORFONT_TEST_FONT_H
@@ -0,0 +1,100 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <numbers>
+#include "vectorfont/transform.h"
+#include "vectorfont/hershey.h"
+#include "test_font.h"
+
+TEST_CASE( "Affine transforms", "[transform-affine]")
+{
+	const auto affine = vectorfont::Affine::translation(10,20) * vectorfont::Affine::scaling(2,3);
+	REQUIRE( affine.map_x(1,1) == 12 );
+	REQUIRE( affine.map_y(1,1) == 23 );
+
+	const auto rotate = vectorfont::Affine::rotation(std::numbers::pi_v<float> / 2);
+	REQUIRE( std::abs(rotate.map_x(1,0)) < 1e-6f );
+	REQUIRE( std::abs(rotate.map_y(1,0) - 1) < 1e-6f );
+
+	const auto font = vectorfont::Affine::font_scale(16,32,100,50);
+	REQUIRE( font.map_x(4,8) == 102 );
+	REQUIRE( font.map_y(4,8) == 46 );
+}
+
+TEST_CASE( "Point transformation", "[transform-points]")
+{
+	const auto affine = vectorfont::Affine::translation(0.5f,-3) * vectorfont::Affine::shear(0.25f) * vectorfont::Affine::scaling(1.5f,-2);
+
+	std::vector<int16_t> points;
+	for(int i = 0; i < 37; ++i)
+		points.push_back(static_cast<int16_t>(i * 7 - 100));
+
+	std::vector<float> output(points.size(),-1);
+	std::vector<int32_t> ioutput(points.size(),-1);
+	vectorfont::transform_points(affine,std::span<const int16_t>(points),std::span<float>(output));
+	vectorfont::transform_points(affine,std::span<const int16_t>(points),std::span<int32_t>(ioutput));
+
+	for(size_t i = 0; i + 1 < points.size(); i += 2)
+	{
+		REQUIRE( output[i] == affine.map_x(points[i],points[i + 1]) );
+		REQUIRE( output[i + 1] == affine.map_y(points[i],points[i + 1]) );
+		REQUIRE( ioutput[i] == std::lrint(output[i]) );
+		REQUIRE( ioutput[i + 1] == std::lrint(output[i + 1]) );
+	}
+	REQUIRE( output.back() == -1 );
+
+	std::vector<float> x(points.begin(),points.end());
+	std::vector<float> y(points.rbegin(),points.rend());
+	vectorfont::transform_points(affine,x,y);
+	for(size_t i = 0; i < points.size(); ++i)
+	{
+		REQUIRE( x[i] == affine.map_x(points[i],points[points.size() - 1 - i]) );
+		REQUIRE( y[i] == affine.map_y(points[i],points[points.size() - 1 - i]) );
+	}
+}
+
+TEST_CASE( "Transformed execution", "[transform-execute]")
+{
+	auto p_font = vectorfont::parse_hershey_font(test_font_svg);
+	REQUIRE( p_font != nullptr );
+
+	const auto affine = vectorfont::Affine::font_scale(16,p_font->units_per_em(),100,50);
+	const std::string text("A?I");
+
+	std::vector<float> expected;
+	float pen_x = 0;
+	p_font->execute(text,[&](vectorfont::Primitive primitive, std::span<const int16_t> args)
+		{
+			if(primitive.command == vectorfont::command::ADVANCE)
+			{
+				pen_x += args[0];
+				expected.push_back(affine.map_x(pen_x,0));
+				expected.push_back(affine.map_y(pen_x,0));
+			}
+			else
+			{
+				expected.push_back(affine.map_x(pen_x + args[0],args[1]));
+				expected.push_back(affine.map_y(pen_x + args[0],args[1]));
+			}
+			return false;
+		});
+
+	std::vector<float> output;
+	size_t pen_positions = 0;
+	vectorfont::execute_transformed(*p_font,text,affine,[&](vectorfont::Primitive primitive, std::span<const float> args)
+		{
+			REQUIRE( primitive.command != vectorfont::command::ADVANCE );
+			pen_positions += (primitive.command == vectorfont::command::PEN_POSITION);
+			output.insert(output.end(),args.begin(),args.end());
+			return false;
+		});
+	REQUIRE( output == expected );
+	REQUIRE( pen_positions == text.size() );
+
+	const auto size = vectorfont::layout_size(*p_font,text);
+	std::vector<float> x0(size.segments), y0(size.segments), x1(size.segments), y1(size.segments);
+	vectorfont::layout_segments(*p_font,text,vectorfont::SegmentBuffers<float>{x0,y0,x1,y1},affine);
+	REQUIRE( x0[0] == affine.map_x(1,0) );
+	REQUIRE( y1[0] == affine.map_y(9,20) );
+}
@@ -12,10 +12,15 @@
 #include <charconv>
 #include <iterator>
 #include <array>
+#include <algorithm>
 #include <memory>
 #include <functional>
 #include <string_view>
+#include <limits>
+#include <cmath>
+#include <type_traits>
 #include "vectorfont/hershey.h"
+#include "vectorfont/builder.h"
 #include "vectorfont/xml.h"
 
 namespace vectorfont
@@ -28,10 +33,11 @@ namespace vectorfont
 //	marks. The tokens are returned through a callback.
 //	Returns the number of tokens found.
 //=============================================================================
+template<typename F>
 static 
 int
 tokenize(	const std::string_view & str,
-					std::function<bool(const std::string_view &)> callback,
+					F && callback,
 					std::string_view delimeters = ",",
 					std::string_view quotes = "\"'" )
 {
@@ -105,8 +111,9 @@ tokenize(	const std::string_view & str,
 }
 
 
+template<typename F>
 static int
-parse_svg_path_data(const std::string_view src, std::function<bool (char,const std::array<int,8> &, int argc)> callback)
+parse_svg_path_data(const std::string_view src, F && callback)
 {
 	std::array<int,8>	args;
 	char 							command = 0;
@@ -166,29 +173,103 @@ parse_svg_path_data(const std::string_view src, std::function<bool (char,const s
 }
 
 
+//=============================================================================
+//	decode_utf8
+//-----------------------------------------------------------------------------
+//	Decodes the first UTF-8 encoded character in the string. Returns the 
+//	number of bytes consumed or 0 if the string is empty or the sequence is
+//	malformed. 
+//=============================================================================
+static size_t
+decode_utf8(const std::string_view str, uint32_t & code)
+{
+	if(str.empty())
+		return 0;
+
+	const auto lead = static_cast<unsigned char>(str[0]);
+	size_t length = 1;
+
+	if(lead < 0x80)				{code = lead; return 1;}
+	else if(lead < 0xC0)	return 0;
+	else if(lead < 0xE0)	{code = lead & 0x1F; length = 2;}
+	else if(lead < 0xF0)	{code = lead & 0x0F; length = 3;}
+	else if(lead < 0xF8)	{code = lead & 0x07; length = 4;}
+	else									return 0;
+
+	if(str.size() < length)
+		return 0;
+
+	for(size_t i = 1; i < length; ++i)
+	{
+		const auto ch = static_cast<unsigned char>(str[i]);
+		if((ch & 0xC0) != 0x80)
+			return 0;
+		code = (code << 6) | (ch & 0x3F);
+	}
+
+	return length;
+}
+
+//=============================================================================
+//	to_coordinate
+//-----------------------------------------------------------------------------
+//	Converts a value read from the file, multiplied by the scale, to the 
+//	font's coordinate type. Integral types are rounded to the nearest unit.
+//	Returns false if the value can not be represented by the type.
+//=============================================================================
+template<typename T>
+static bool
+to_coordinate(int value, float scale, T & out)
+{
+	if constexpr (std::is_integral_v<T>)
+	{
+		const long scaled = (scale == 1.0f) ? value : std::lround(value * scale);
+		if((scaled < std::numeric_limits<T>::min()) || (scaled > std::numeric_limits<T>::max()))
+			return false;
+		out = static_cast<T>(scaled);
+	}
+	else
+		out = static_cast<T>(value * scale);
+	return true;
+}
+
+template<typename T>
 static bool
-parse_glyph(const ade::xml::XMLElement & glyph_element, vectorfont::Font & font)
+parse_glyph(const ade::xml::XMLElement & glyph_element, vectorfont::BasicFontBuilder<T> & font, float scale, std::pmr::string & attr)
 {
-	std::string attr;
 	uint32_t code = 0U;
 	bool b_error = false;
 
 	if(!glyph_element.get_attribute("unicode",attr))
 		return true;
 
-	if(attr.size() > 1)
+	// Glyphs for ligatures (more than one character) are not supported.
+	const auto length = decode_utf8(attr,code);
+	if((length == 0) || (length != attr.size()))
 		return false;
 
-	code = attr[0];
-
-	int adv_x = font.missing_adv_x;
-	glyph_element.get_attribute("horiz-adv-x",adv_x);
+	T adv_x = font.font().missing_adv_x();
+	int attr_adv_x = 0;
+	if(glyph_element.get_attribute("horiz-adv-x",attr_adv_x) && !to_coordinate(attr_adv_x,scale,adv_x))
+	{
+		std::cerr << "Glyph advance is out of range for the font type!\n";
+		return true;
+	}
 
 	if(glyph_element.get_attribute("d",attr))
 	{
-		font.start_glyph(code,adv_x);
-		int16_t cursor_x = 0;
-		int16_t cursor_y = 0;
+		if(!font.start_glyph(code,adv_x))
+		{
+			std::cerr << "Too many glyphs in font!\n";
+			return true;
+		}
+
+		int cursor_x = 0;
+		int cursor_y = 0;
+		bool b_capacity = true;
+		bool b_range = true;
+		T x = 0;
+		T y = 0;
 
 		parse_svg_path_data(attr, [&](char command,const std::array<int,8> & args,int argc) -> bool
 			{
@@ -197,15 +278,35 @@ parse_glyph(const ade::xml::XMLElement & glyph_element, vectorfont::Font & font)
 					case 2 :
 						switch(command)
 						{
-							case 'M' : cursor_x = args[0]; cursor_y = args[1]; 		font.moveto(cursor_x,cursor_y); break;
-							case 'L' : cursor_x = args[0]; cursor_y = args[1]; 		font.lineto(cursor_x,cursor_y); break;
-							case 'm' : cursor_x += args[0]; cursor_y += args[1]; 	font.moveto(cursor_x,cursor_y); break;
-							case 'l' : cursor_x += args[0]; cursor_y += args[1]; 	font.lineto(cursor_x,cursor_y); break;
+							case 'M' : 
+							case 'L' : cursor_x = args[0]; cursor_y = args[1]; 		break;
+							case 'm' : 
+							case 'l' : cursor_x += args[0]; cursor_y += args[1]; 	break;
 							default : 	
 								//std::cerr << "Unsupported command '" << command << "'\n"; 
 								//b_error = true; 
 								return false;
 						}
+
+						b_range = to_coordinate(cursor_x,scale,x) && to_coordinate(cursor_y,scale,y);
+						if(!b_range)
+						{
+							std::cerr << "Coordinate is out of range for the font type!\n";
+							b_error = true;
+							return false;
+						}
+
+						if((command == 'M') || (command == 'm'))
+							b_capacity = font.moveto(x,y);
+						else
+							b_capacity = font.lineto(x,y);
+
+						if(!b_capacity)
+						{
+							std::cerr << "Font geometry exceeds the index capacity!\n";
+							b_error = true;
+							return false;
+						}
 						break;
 
 					default :
@@ -219,63 +320,156 @@ parse_glyph(const ade::xml::XMLElement & glyph_element, vectorfont::Font & font)
 	return b_error;
 }
 
+template<typename T>
 static bool
-parse_font_face(const ade::xml::XMLElement & font_face, vectorfont::Font & font)
+parse_font_face(const ade::xml::XMLElement & font_face, vectorfont::BasicFontBuilder<T> & font, float scale)
 {
-	font_face.get_attribute("units-per-em", font.units_per_em);
-	font_face.get_attribute("ascent", font.ascent);
-	font_face.get_attribute("descent", font.descent);
+	int units_per_em 	= 0;
+	int ascent 				= 0;
+	int descent 			= 0;
+	font_face.get_attribute("units-per-em", units_per_em);
+	font_face.get_attribute("ascent", ascent);
+	font_face.get_attribute("descent", descent);
+
+	int16_t metrics[3];
+	if(!to_coordinate(ascent,scale,metrics[0]) || !to_coordinate(descent,scale,metrics[1]) || !to_coordinate(units_per_em,scale,metrics[2]))
+	{
+		std::cerr << "Font metrics are out of range!\n";
+		return true;
+	}
+
+	font.set_metrics(metrics[0],metrics[1],metrics[2]);
 	return false;
 }
 
+//=============================================================================
+//	font_scale
+//-----------------------------------------------------------------------------
+//	Returns the scale that converts the font's units to the requested units 
+//	per em, or 1 if the font is loaded as it is stored.
+//=============================================================================
+static float
+font_scale(const ade::xml::XMLElement & font_element, int16_t units_per_em)
+{
+	if(units_per_em <= 0)
+		return 1.0f;
+
+	int source_units_per_em = 0;
+	const auto p_font_face = font_element.get_element("font-face");
+	if(!p_font_face || !p_font_face->get_attribute("units-per-em",source_units_per_em) || (source_units_per_em <= 0))
+		return 1.0f;
+
+	return static_cast<float>(units_per_em) / static_cast<float>(source_units_per_em);
+}
+
+//=============================================================================
+//	count_font_geometry
+//-----------------------------------------------------------------------------
+//	Counts the glyphs and path commands in the font element so that the 
+//	builder can be sized before the glyphs are parsed. Every supported 
+//	command has one primitive, so the commands are counted without parsing
+//	the paths. Unsupported commands are not counted.
+//=============================================================================
+static void
+count_font_geometry(const ade::xml::XMLElement & font_element, size_t & glyph_count, size_t & primitive_count, std::pmr::string & attr)
+{
+	glyph_count 		= 0;
+	primitive_count = 0;
+
+	auto count_glyph = [&](const ade::xml::XMLElement * p_element)->bool
+		{
+			if(p_element->get_attribute("d",attr))
+			{
+				++glyph_count;
+				primitive_count += std::count_if(attr.begin(),attr.end(),[](char ch){return (ch == 'M') || (ch == 'L') || (ch == 'm') || (ch == 'l');});
+			}
+			return false;
+		};
+
+	// Passed by reference so that the std::function doesn't allocate a copy.
+	font_element.find_elements("glyph",std::ref(count_glyph));
+}
+
+template<typename T>
 static
-std::unique_ptr<vectorfont::Font>
-parse_font_element(const ade::xml::XMLElement & font_element)
+vectorfont::BasicFontPtr<T>
+parse_font_element(const ade::xml::XMLElement & font_element, int16_t units_per_em, std::pmr::memory_resource * p_resource)
 {
-	auto p_font = std::make_unique<vectorfont::Font>();
-	auto & font = *p_font;
+	vectorfont::BasicFontBuilder<T> font(p_resource);
+	const float scale = font_scale(font_element,units_per_em);
+	std::pmr::string attr(p_resource);		// Attribute values are copied here, it is reused by each glyph
+
+	size_t glyph_count 			= 0;
+	size_t primitive_count 	= 0;
+	count_font_geometry(font_element,glyph_count,primitive_count,attr);
+	font.reserve(glyph_count,primitive_count,primitive_count * 2);
 
 	int advance_x = 0;
+	std::pmr::string id(p_resource);
 
-	font_element.get_attribute("id",font.id);
+	font_element.get_attribute("id",id);
 	font_element.get_attribute("horiz-adv-x",advance_x);
+	font.set_id(id);
 
-	std::cout << "id: " << font.id << " advx: " << advance_x << std::endl;
+	std::cout << "id: " << id << " advx: " << advance_x << std::endl;
 
 	bool b_error = false;
 
-	font_element.find_elements("",[&](const ade::xml::XMLElement * p_element)->bool
+	auto parse_element = [&](const ade::xml::XMLElement * p_element)->bool
 		{
-			auto name = p_element->value();
-			if(name == "font-face") 						b_error = parse_font_face(*p_element,font);
-			else if(name == "missing-glyph")		p_element->get_attribute("horiz-adv-x", font.missing_adv_x);
-			else if(name == "glyph")						b_error = parse_glyph(*p_element,font);
+			const auto & name = p_element->value();
+			if(name == "font-face") 						b_error = parse_font_face(*p_element,font,scale);
+			else if(name == "missing-glyph")
+			{
+				int attr_adv_x = 0;
+				T missing_adv_x = 0;
+				if(p_element->get_attribute("horiz-adv-x", attr_adv_x))
+				{
+					if(to_coordinate(attr_adv_x,scale,missing_adv_x))
+						font.set_missing_advance(missing_adv_x);
+					else
+					{
+						std::cerr << "Missing glyph advance is out of range for the font type!\n";
+						b_error = true;
+					}
+				}
+			}
+			else if(name == "glyph")						b_error = parse_glyph(*p_element,font,scale,attr);
 			else std::cout << "Unhandled element: '" << name << "'\n";
 			return b_error;
-		});
+		};
+
+	font_element.find_elements("",std::ref(parse_element));
 
 /*
-	std::cout 	<< "\nFONT: id: " << font.id 
-							<< "\n    ascent:          " << font.ascent
-							<< "\n    descent:         " << font.descent
-							<< "\n    units-per-em:    " << font.units_per_em
-							<< "\n    missing-adv-x:   " << font.missing_adv_x
+	std::cout 	<< "\nFONT: id: " << font.font().id() 
+							<< "\n    ascent:          " << font.font().ascent()
+							<< "\n    descent:         " << font.font().descent()
+							<< "\n    units-per-em:    " << font.font().units_per_em()
+							<< "\n    missing-adv-x:   " << font.font().missing_adv_x()
 							<< std::endl;
 */
 	if(b_error)
 		return nullptr;
 
-	return p_font;
+	return font.build();
 }
 
-std::unique_ptr<vectorfont::Font>
-parse_hershey_font(const std::string_view src)
+//=============================================================================
+//	parse_document
+//-----------------------------------------------------------------------------
+//	Parses the SVG document and builds the font from its font element. A 
+//	units_per_em of zero loads the font as it is stored.
+//=============================================================================
+template<typename T>
+static
+vectorfont::BasicFontPtr<T>
+parse_document(const std::string_view src, int16_t units_per_em, std::pmr::memory_resource * p_resource)
 {
-
 	//-------------------------------------------------------------------------
 	//  Parse the document
 	//-------------------------------------------------------------------------
-	ade::xml::XMLDocument   doc;
+	ade::xml::XMLDocument   doc(p_resource);
 
 	if(doc.parse(src.data(),src.size()))
 	{
@@ -312,22 +506,75 @@ parse_hershey_font(const std::string_view src)
 		return {};
 	}
 	
-	return parse_font_element(*p_font);
+	return parse_font_element<T>(*p_font,units_per_em,p_resource);
 }
 
-
-std::unique_ptr<vectorfont::Font>
-load_hershey_font(std::string_view filename)
+//=============================================================================
+//	read_file
+//-----------------------------------------------------------------------------
+//	Reads the whole file into a string allocated from the memory resource.
+//	Returns false if the file can not be opened.
+//=============================================================================
+static bool
+read_file(std::string_view filename, std::pmr::string & str)
 {
 	std::ifstream infile(filename.data());
 	if(infile.fail())
+		return false;
+
+	str.assign(std::istreambuf_iterator<char>{infile},{});
+	return true;
+}
+
+template<typename T>
+vectorfont::BasicFontPtr<T>
+parse_hershey_font(const std::string_view src, std::pmr::memory_resource * p_resource)
+{
+	return parse_document<T>(src,0,p_resource);
+}
+
+template<typename T>
+vectorfont::BasicFontPtr<T>
+parse_hershey_font_scaled(const std::string_view src, int16_t units_per_em, std::pmr::memory_resource * p_resource)
+{
+	return parse_document<T>(src,units_per_em,p_resource);
+}
+
+template<typename T>
+vectorfont::BasicFontPtr<T>
+load_hershey_font(std::string_view filename, std::pmr::memory_resource * p_resource)
+{
+	std::pmr::string str(p_resource);
+	if(!read_file(filename,str))
 		return {};
 
-	std::string str(std::istreambuf_iterator<char>{infile}, {});
+	return parse_document<T>(str,0,p_resource);
+}
 
-	return parse_hershey_font(str);
+template<typename T>
+vectorfont::BasicFontPtr<T>
+load_hershey_font_scaled(std::string_view filename, int16_t units_per_em, std::pmr::memory_resource * p_resource)
+{
+	std::pmr::string str(p_resource);
+	if(!read_file(filename,str))
+		return {};
+
+	return parse_document<T>(str,units_per_em,p_resource);
 }
 
+template vectorfont::BasicFontPtr<int8_t>		parse_hershey_font<int8_t>(const std::string_view src, std::pmr::memory_resource * p_resource);
+template vectorfont::BasicFontPtr<int16_t>		parse_hershey_font<int16_t>(const std::string_view src, std::pmr::memory_resource * p_resource);
+template vectorfont::BasicFontPtr<float>		parse_hershey_font<float>(const std::string_view src, std::pmr::memory_resource * p_resource);
+template vectorfont::BasicFontPtr<int8_t>		load_hershey_font<int8_t>(std::string_view filename, std::pmr::memory_resource * p_resource);
+template vectorfont::BasicFontPtr<int16_t>		load_hershey_font<int16_t>(std::string_view filename, std::pmr::memory_resource * p_resource);
+template vectorfont::BasicFontPtr<float>		load_hershey_font<float>(std::string_view filename, std::pmr::memory_resource * p_resource);
+template vectorfont::BasicFontPtr<int8_t>		parse_hershey_font_scaled<int8_t>(const std::string_view src, int16_t units_per_em, std::pmr::memory_resource * p_resource);
+template vectorfont::BasicFontPtr<int16_t>		parse_hershey_font_scaled<int16_t>(const std::string_view src, int16_t units_per_em, std::pmr::memory_resource * p_resource);
+template vectorfont::BasicFontPtr<float>		parse_hershey_font_scaled<float>(const std::string_view src, int16_t units_per_em, std::pmr::memory_resource * p_resource);
+template vectorfont::BasicFontPtr<int8_t>		load_hershey_font_scaled<int8_t>(std::string_view filename, int16_t units_per_em, std::pmr::memory_resource * p_resource);
+template vectorfont::BasicFontPtr<int16_t>		load_hershey_font_scaled<int16_t>(std::string_view filename, int16_t units_per_em, std::pmr::memory_resource * p_resource);
+template vectorfont::BasicFontPtr<float>		load_hershey_font_scaled<float>(std::string_view filename, int16_t units_per_em, std::pmr::memory_resource * p_resource);
+
 
 } // namespace vectorfont
 